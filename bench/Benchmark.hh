@@ -0,0 +1,84 @@
+#ifndef Benchmark_h
+#define Benchmark_h 1
+
+// Minimal microbenchmark harness in the style of Google Benchmark, so the
+// kernel benchmarks need nothing beyond Geant4. Each benchmark loops on
+// state.KeepRunning(); the harness doubles the iteration count until one
+// measurement takes at least the minimum time and reports time per
+// iteration and, if set, items per second.
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class BenchmarkState
+{
+  public:
+    explicit BenchmarkState(std::size_t iterations)
+    : fIterations(iterations), fRemaining(iterations), fItems(0) {}
+
+    bool KeepRunning()
+    {
+      if (fRemaining == fIterations) fStart = Clock::now();
+      if (fRemaining-- > 0) return true;
+      fStop = Clock::now();
+      return false;
+    }
+
+    // Work items per iteration (e.g. records written), for the items/s column
+    void SetItemsProcessed(std::size_t items) { fItems = items; }
+
+    std::size_t GetIterations() const { return fIterations; }
+    std::size_t GetItemsProcessed() const { return fItems; }
+    double GetSeconds() const { return std::chrono::duration<double>(fStop - fStart).count(); }
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    std::size_t fIterations;
+    std::size_t fRemaining;
+    std::size_t fItems;
+    Clock::time_point fStart;
+    Clock::time_point fStop;
+};
+
+// Keeps the compiler from discarding a result that is otherwise unused
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  const volatile T sink = value;
+  (void)sink;
+#endif
+}
+
+using BenchmarkFunction = void (*)(BenchmarkState&);
+
+struct BenchmarkEntry
+{
+  std::string name;
+  BenchmarkFunction function;
+};
+
+// All benchmarks, in registration order
+inline std::vector<BenchmarkEntry>& GetBenchmarks()
+{
+  static std::vector<BenchmarkEntry> benchmarks;
+  return benchmarks;
+}
+
+struct BenchmarkRegistration
+{
+  BenchmarkRegistration(const char* name, BenchmarkFunction function)
+  {
+    GetBenchmarks().push_back({ name, function });
+  }
+};
+
+#define TUNGSTEN_BENCHMARK(function) \
+  static BenchmarkRegistration function##Registration(#function, function)
+
+#endif
@@ -0,0 +1,294 @@
+// Microbenchmarks of the hot kernels of tungsten_sim, run without a run
+// manager or /run/initialize so each one takes seconds:
+//
+//   BM_FieldValue        LimitedRegionField::GetFieldValue over points inside
+//                        and outside the solenoid
+//   BM_Classify          the per-step species and decay checks of the tracking
+//                        action and the detector SDs (ParticleClassifier),
+//                        with G4Decay processes registered for pi+-, mu+
+//   BM_HitArenaEvent     one event of hits through the HitArena and the bulk
+//                        hand-off to HitWriter (event-loop side of the hit file)
+//   BM_HitFile           HitWriter end to end: columns and disk writes
+//   BM_FieldPropagation  a 1 GeV mu+ carried 10 m through the 7 T region with
+//                        the chord finder configured by ElectricFieldSetup
+//
+// Usage: tungsten_bench [name filter] [--min-time seconds]
+
+#include "Benchmark.hh"
+
+#include "LimitedRegionField.hh"
+#include "ElectricFieldSetup.hh"
+#include "ParticleClassifier.hh"
+#include "HitArena.hh"
+#include "HitWriter.hh"
+#include "Logger.hh"
+
+#include "G4ChordFinder.hh"
+#include "G4VIntegrationDriver.hh"
+#include "G4EquationOfMotion.hh"
+#include "G4ChargeState.hh"
+#include "G4FieldTrack.hh"
+#include "G4Proton.hh"
+#include "G4Neutron.hh"
+#include "G4Gamma.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4MuonPlus.hh"
+#include "G4MuonMinus.hh"
+#include "G4PionPlus.hh"
+#include "G4PionMinus.hh"
+#include "G4PionZero.hh"
+#include "G4KaonPlus.hh"
+#include "G4Decay.hh"
+#include "G4StepLimiter.hh"
+#include "G4ProcessManager.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+namespace
+{
+  const std::size_t kBatch = 1024;
+
+  HitRecord MakeHit(std::size_t i)
+  {
+    HitRecord record{};
+    record.eventID = G4int(i/16);
+    record.species = G4int(i % 4);
+    record.detectorID = 1 + G4int(i % 2);
+    record.kineticEnergy = 100.f + i;
+    record.position[2] = 1500.f;
+    record.direction[2] = 1.f;
+    record.weight = 1.f;
+    record.parentSpecies = ParticleClassifier::kOther;
+    record.creatorProcess = -1;
+    return record;
+  }
+
+  // There is no physics list here, so give pi+, pi- and mu+ a process
+  // manager with a G4Decay, as the physics list would before
+  // ParticleClassifier::Build(). Returns those decays and a non-decay
+  // process, the processes BM_Classify draws from.
+  std::vector<const G4VProcess*> RegisterProcesses()
+  {
+    std::vector<const G4VProcess*> processes;
+    G4ParticleDefinition* decaying[] = {
+      G4PionPlus::Definition(), G4PionMinus::Definition(), G4MuonPlus::Definition()
+    };
+    for (G4ParticleDefinition* particle : decaying) {
+      G4ProcessManager* manager = particle->GetProcessManager();
+      if (!manager) {
+        manager = new G4ProcessManager(particle);
+        particle->SetProcessManager(manager);
+      }
+      auto* decay = new G4Decay();
+      manager->AddProcess(decay);
+      manager->SetProcessOrdering(decay, idxPostStep);
+      manager->SetProcessOrdering(decay, idxAtRest);
+      processes.push_back(decay);
+    }
+    processes.push_back(new G4StepLimiter());
+    return processes;
+  }
+}
+
+void BM_FieldValue(BenchmarkState& state)
+{
+  FieldParameters parameters;
+  LimitedRegionField field(parameters);
+
+  // z from -10 m to 15 m, so both sides of the region edges are covered
+  std::vector<G4double> points(4*kBatch, 0.);
+  for (std::size_t i = 0; i < kBatch; ++i) {
+    points[4*i + 0] = 10.*cm;
+    points[4*i + 2] = -10.*m + 25.*m*i/kBatch;
+  }
+
+  G4double value[6];
+  while (state.KeepRunning()) {
+    for (std::size_t i = 0; i < kBatch; ++i) {
+      field.GetFieldValue(&points[4*i], value);
+      DoNotOptimize(value[2]);
+    }
+  }
+  state.SetItemsProcessed(kBatch);
+}
+TUNGSTEN_BENCHMARK(BM_FieldValue);
+
+void BM_Classify(BenchmarkState& state)
+{
+  // Registered once, before the first Build()
+  static const std::vector<const G4VProcess*> processes = RegisterProcesses();
+  ParticleClassifier* classifier = ParticleClassifier::Instance();
+  classifier->Build();
+
+  // Roughly the mix of tracks in the tungsten shower
+  const G4ParticleDefinition* mix[] = {
+    G4Gamma::Definition(), G4Gamma::Definition(), G4Gamma::Definition(),
+    G4Gamma::Definition(), G4Electron::Definition(), G4Electron::Definition(),
+    G4Positron::Definition(), G4Neutron::Definition(), G4Neutron::Definition(),
+    G4Proton::Definition(), G4PionPlus::Definition(), G4PionMinus::Definition(),
+    G4PionZero::Definition(), G4KaonPlus::Definition(), G4MuonPlus::Definition(),
+    G4MuonMinus::Definition()
+  };
+  const std::size_t nofTypes = sizeof(mix)/sizeof(mix[0]);
+
+  // The process that limited each step: the pion and muon decays (matching
+  // the particle or not) and the step limiter
+  std::vector<const G4ParticleDefinition*> particles(kBatch);
+  std::vector<const G4VProcess*> stepProcesses(kBatch);
+  for (std::size_t i = 0; i < kBatch; ++i) {
+    particles[i] = mix[(i*7) % nofTypes];
+    stepProcesses[i] = processes[(i/3) % processes.size()];
+  }
+
+  while (state.KeepRunning()) {
+    G4int scored = 0;
+    for (std::size_t i = 0; i < kBatch; ++i) {
+      const ParticleClassifier::Species species = classifier->Classify(particles[i]);
+      if (ParticleClassifier::IsMuon(species)) ++scored;
+      if (ParticleClassifier::IsChargedPion(species)
+          && classifier->IsDecay(species, stepProcesses[i])) {
+        ++scored;
+      }
+    }
+    DoNotOptimize(scored);
+  }
+  state.SetItemsProcessed(kBatch);
+}
+TUNGSTEN_BENCHMARK(BM_Classify);
+
+void BM_HitArenaEvent(BenchmarkState& state)
+{
+  const std::size_t hitsPerEvent = 16;
+  const G4String fileName = "tungsten_bench_hits.bin";
+  HitWriter writer;
+  writer.Open(fileName);
+  HitArena* arena = HitArena::Instance();
+
+  std::size_t i = 0;
+  while (state.KeepRunning()) {
+    arena->Reset();
+    for (std::size_t k = 0; k < hitsPerEvent; ++k) arena->Add(MakeHit(i++));
+    writer.Write(arena->GetRecords(), arena->GetSize());
+  }
+  state.SetItemsProcessed(hitsPerEvent);
+
+  writer.Close();
+  std::remove(fileName.c_str());
+}
+TUNGSTEN_BENCHMARK(BM_HitArenaEvent);
+
+void BM_HitFile(BenchmarkState& state)
+{
+  const std::size_t nofHits = 16*HitWriter::kBlockSize;
+  const G4String fileName = "tungsten_bench_hits.bin";
+  std::vector<HitRecord> hits(nofHits);
+  for (std::size_t i = 0; i < nofHits; ++i) hits[i] = MakeHit(i);
+
+  HitWriter writer;
+  while (state.KeepRunning()) {
+    writer.Open(fileName);
+    writer.Write(hits.data(), hits.size());
+    writer.Close();  // waits for the column conversion and the disk writes
+  }
+  state.SetItemsProcessed(nofHits);
+  std::remove(fileName.c_str());
+}
+TUNGSTEN_BENCHMARK(BM_HitFile);
+
+void BM_FieldPropagation(BenchmarkState& state)
+{
+  FieldParameters parameters;
+  ElectricFieldSetup setup(parameters);
+  G4FieldManager* fieldManager = setup.GetFieldManager();
+  G4ChordFinder* chordFinder = fieldManager->GetChordFinder();
+  G4EquationOfMotion* equation = chordFinder->GetIntegrationDriver()->GetEquationOfMotion();
+
+  const G4ParticleDefinition* muon = G4MuonPlus::Definition();
+  const G4double mass = muon->GetPDGMass();
+  const G4double charge = muon->GetPDGCharge();
+  const G4double kineticEnergy = 1.*GeV;
+  const G4double momentum = std::sqrt(kineticEnergy*(kineticEnergy + 2.*mass));
+  const G4ThreeVector direction = G4ThreeVector(0.2, 0., 1.).unit();
+  const G4double pathLength = 10.*m;
+  const G4double maxStep = 1.*m;
+
+  while (state.KeepRunning()) {
+    G4FieldTrack track(G4ThreeVector(), 0., direction, kineticEnergy, mass, charge);
+    equation->SetChargeMomentumMass(G4ChargeState(charge, 0., muon->GetPDGSpin()),
+                                    momentum, mass);
+    chordFinder->ResetStepEstimate();
+    chordFinder->OnComputeStep(&track);  // new track for the interpolation driver
+
+    // Same accuracy as G4PropagatorInField: deltaOneStep relative to the step
+    G4double length = 0.;
+    for (G4int n = 0; length < pathLength && n < 100000; ++n) {
+      const G4double step = std::min(maxStep, pathLength - length);
+      const G4double epsilon = std::min(fieldManager->GetMaximumEpsilonStep(),
+        std::max(fieldManager->GetMinimumEpsilonStep(),
+                 fieldManager->GetDeltaOneStep()/step));
+      length += chordFinder->AdvanceChordLimited(track, step, epsilon,
+                                                 track.GetPosition(), 0.);
+    }
+    DoNotOptimize(track.GetPosition().z());
+  }
+  state.SetItemsProcessed(1);
+}
+TUNGSTEN_BENCHMARK(BM_FieldPropagation);
+
+int main(int argc, char** argv)
+{
+  std::string filter;
+  double minTime = 0.5;
+  for (G4int i = 1; i < argc; ++i) {
+    const std::string argument = argv[i];
+    if (argument == "--min-time" && i + 1 < argc) {
+      minTime = std::atof(argv[++i]);
+    } else if (argument[0] == '-') {
+      std::cerr << "Usage: " << argv[0] << " [name filter] [--min-time seconds]" << std::endl;
+      return 1;
+    } else {
+      filter = argument;
+    }
+  }
+
+  // Keep the field setup quiet
+  Logger::SetLevel(Logger::kQuiet);
+
+  std::cout << std::left << std::setw(24) << "Benchmark" << std::right
+            << std::setw(14) << "Iterations" << std::setw(16) << "ns/iteration"
+            << std::setw(16) << "items/s" << std::endl;
+
+  for (const BenchmarkEntry& benchmark : GetBenchmarks()) {
+    if (benchmark.name.find(filter) == std::string::npos) continue;
+
+    // Grow the iteration count until one measurement lasts minTime
+    std::size_t iterations = 1;
+    for (;;) {
+      BenchmarkState state(iterations);
+      benchmark.function(state);
+      const double seconds = state.GetSeconds();
+      if (seconds >= minTime || iterations >= (std::size_t(1) << 40)) {
+        const double perIteration = seconds/iterations;
+        std::cout << std::left << std::setw(24) << benchmark.name << std::right
+                  << std::setw(14) << iterations
+                  << std::setw(16) << std::fixed << std::setprecision(1) << perIteration*1e9;
+        if (state.GetItemsProcessed() > 0 && perIteration > 0.) {
+          std::cout << std::setw(16) << std::scientific << std::setprecision(3)
+                    << state.GetItemsProcessed()/perIteration;
+        }
+        std::cout << std::defaultfloat << std::endl;
+        break;
+      }
+      const double growth = seconds > 0. ? 1.4*minTime/seconds : 10.;
+      iterations = std::size_t(iterations*std::min(10., std::max(2., growth)));
+    }
+  }
+  return 0;
+}
@@ -3,6 +3,9 @@
 
 #include "G4VUserActionInitialization.hh"
 
+class G4GenericMessenger;
+class G4VSteppingVerbose;
+
 class ActionInitialization : public G4VUserActionInitialization
 {
   public:
@@ -11,6 +14,20 @@ class ActionInitialization : public G4VUserActionInitialization
 
     virtual void BuildForMaster() const;
     virtual void Build() const;
+#ifdef TUNGSTEN_STEP_PROFILER
+    virtual G4VSteppingVerbose* InitializeSteppingVerbose() const;
+#endif
+
+  private:
+    // Master-side commands for settings shared by all threads
+    G4GenericMessenger* fLoggerMessenger;
+    G4GenericMessenger* fStackingMessenger;
+    G4GenericMessenger* fPhaseSpaceMessenger;
+    G4GenericMessenger* fScanMessenger;
+    G4GenericMessenger* fOutputMessenger;
+    G4GenericMessenger* fHistogramMessenger;
+    G4GenericMessenger* fTelemetryMessenger;
+    G4GenericMessenger* fProfilerMessenger;  // nullptr without the profiler
 };
 
-#endif
\ No newline at end of file
+#endif
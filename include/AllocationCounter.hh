@@ -0,0 +1,29 @@
+#ifndef AllocationCounter_h
+#define AllocationCounter_h 1
+
+#include <cstddef>
+
+// Counts the calls to the global operator new on each thread. Only built
+// with -DTUNGSTEN_COUNT_ALLOCATIONS=ON, which replaces operator new and
+// delete for the whole program; used to check that the hit path does not
+// allocate in steady state.
+class AllocationCounter
+{
+  public:
+    // Allocations made by the calling thread so far
+    static std::size_t Get();
+
+    // Adds the allocations made during its lifetime to a counter
+    class Scope
+    {
+      public:
+        explicit Scope(std::size_t& counter) : fCounter(counter), fStart(Get()) {}
+        ~Scope() { fCounter += Get() - fStart; }
+
+      private:
+        std::size_t& fCounter;
+        std::size_t fStart;
+    };
+};
+
+#endif
@@ -4,10 +4,16 @@
 #include "G4VUserDetectorConstruction.hh"
 #include "globals.hh"
 #include "G4ThreeVector.hh"
+#include "G4Cache.hh"
+#include "LimitedRegionField.hh"
 
 class G4VPhysicalVolume;
 class G4LogicalVolume;
+class G4Box;
+class G4Tubs;
 class ElectricFieldSetup;  // Rename as needed but keep using this for magnetic field
+class G4GenericMessenger;
+class TrackingCuts;
 
 class DetectorConstruction : public G4VUserDetectorConstruction
 {
@@ -26,13 +32,80 @@ class DetectorConstruction : public G4VUserDetectorConstruction
     // In DetectorConstruction.hh, add these to the public section:
     G4ThreeVector GetDetector1Position() const { return fDetector1Position; }
     G4ThreeVector GetDetector2Position() const { return fDetector2Position; }
+
+    // Field setup of the calling thread (nullptr before ConstructSDandField)
+    ElectricFieldSetup* GetFieldSetup() const { return fElectricFieldSetup.Get(); }
+
+    // Run CheckOverlaps on every placement and print the navigation voxel
+    // statistics. Call after /run/initialize; returns the number of
+    // overlapping placements.
+    G4int CheckGeometry(G4int resolution = 10000);
+
+    // Design parameters, for the per-run scan output
+    G4double GetTungstenWidth() const { return fTungstenWidth; }
+    G4double GetTungstenLength() const { return fTungstenLength; }
+    G4double GetDetector1Distance() const { return fDetector1Distance; }
+    G4double GetDetector2Distance() const { return fDetector2Distance; }
+    G4double GetDetectorRadius() const { return fDetectorRadius; }
+    const FieldParameters& GetFieldParameters() const { return fField; }
+
+    // /tungsten/geom/ and /tungsten/field/ setters. After /run/initialize
+    // they resize or move the existing volumes (see GeometryChanged).
+    void SetTungstenWidth(G4double value);
+    void SetTungstenLength(G4double value);
+    void SetDetector1Distance(G4double value);
+    void SetDetector2Distance(G4double value);
+    void SetDetectorRadius(G4double value);
+    void SetFieldValue(G4double value);
+    void SetFieldZMin(G4double value);
+    void SetFieldZMax(G4double value);
     
   private:
+    void DefineCommands();
+    void CheckGeometryCommand(G4int resolution);
+    // Apply the parameters to the solids and placements built by Construct()
+    void UpdateGeometry();
+    void GeometryChanged();
+    // Why the parameters put a daughter outside the field envelope
+    // (empty if they do not)
+    G4String FindEnvelopeProblem() const;
+    // Set a dimension unless the result leaves the envelope; false if rejected
+    G4bool SetDimension(G4double& parameter, G4double value, const G4String& name);
+
     G4LogicalVolume* fScoringVolume;
     G4LogicalVolume* fDetector1Volume;
     G4LogicalVolume* fDetector2Volume;
+    G4LogicalVolume* fFieldVolume;  // solenoid envelope with the local field
+
+    // Design parameters
+    G4double fTungstenWidth;
+    G4double fTungstenLength;
+    G4double fTungstenZ;          // centre of the block
+    G4double fDetector1Distance;  // from the tungsten exit face
+    G4double fDetector2Distance;
+    G4double fDetectorRadius;
+    G4double fDetectorThickness;
+
+    // Solenoid; the envelope spans the field zMin..zMax
+    FieldParameters fField;  // shared by the field objects of all threads
+    G4double fFieldRadius;
+
+    // Volumes changed in place by UpdateGeometry()
+    G4Tubs* fEnvelopeSolid;
+    G4Box* fTungstenSolid;
+    G4Tubs* fDetector1Solid;
+    G4Tubs* fDetector2Solid;
+    G4VPhysicalVolume* fEnvelopePlacement;
+    G4VPhysicalVolume* fTungstenPlacement;
+    G4VPhysicalVolume* fDetector1Placement;
+    G4VPhysicalVolume* fDetector2Placement;
+
+    G4bool fCheckOverlaps;  // check each placement in Construct()
+    TrackingCuts* fTrackingCuts;  // shared by all volumes and threads
+    G4GenericMessenger* fMessenger;
+    G4GenericMessenger* fFieldMessenger;
     
-    ElectricFieldSetup* fElectricFieldSetup;  // We'll keep the same name for simplicity
+    G4Cache<ElectricFieldSetup*> fElectricFieldSetup;  // one per thread
     // In the private section of DetectorConstruction.hh:
     G4ThreeVector fDetector1Position;
     G4ThreeVector fDetector2Position;
@@ -0,0 +1,29 @@
+#ifndef DetectorSD_h
+#define DetectorSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+
+class ParticleClassifier;
+class HitArena;
+
+// Sensitive detector of a detector disc: one hit record for every muon or
+// charged pion that enters it, appended to the thread's HitArena (both
+// discs share it; the record carries the detector ID). Only called for
+// steps inside the disc.
+class DetectorSD : public G4VSensitiveDetector
+{
+  public:
+    DetectorSD(const G4String& name, G4int detectorID);
+    ~DetectorSD() override = default;
+
+    void Initialize(G4HCofThisEvent* hce) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
+
+  private:
+    G4int fDetectorID;  // 1 or 2, as stored in the hit file
+    G4int fEventID;
+    const ParticleClassifier* fClassifier;
+    HitArena* fArena;
+};
+
+#endif
@@ -11,24 +11,54 @@
 #include "G4ChordFinder.hh"
 #include "globals.hh"
 
+class LimitedRegionField;
+struct FieldParameters;
+class G4GenericMessenger;
+
+// Field, equation, stepper, driver and local field manager of one thread.
+// The integration settings can be changed between runs with the
+// /tungsten/field/ commands; the field value and extent come from the
+// shared FieldParameters (/tungsten/field/value, zMin, zMax).
 class ElectricFieldSetup
 {
 public:
-  ElectricFieldSetup();
+  // The field is non-zero for zMin <= z <= zMax of the parameters
+  explicit ElectricFieldSetup(const FieldParameters& parameters);
   ~ElectricFieldSetup();
   
-  void SetMagneticField(G4ThreeVector);
   G4FieldManager* GetFieldManager() { return fFieldManager; }
+
+  // Stepper: ClassicalRK4, DormandPrince745 or ExactHelix
+  void SetStepperType(const G4String& name);
+  // Driver: MagInt (G4MagInt_Driver) or Interpolation (G4InterpolationDriver,
+  // DormandPrince745 only)
+  void SetDriverType(const G4String& name);
+  void SetMinStep(G4double value);
+  void SetDeltaChord(G4double value);
+  void SetDeltaOneStep(G4double value);
+  void SetDeltaIntersection(G4double value);
+  void SetMinEpsilonStep(G4double value);
+  void SetMaxEpsilonStep(G4double value);
+
+  // Field evaluations on this thread since the last reset
+  G4long GetNumberOfFieldCalls() const;
+  void ResetNumberOfFieldCalls();
   
 private:
+  void UpdateChordFinder();
+  void DefineCommands();
+
   G4FieldManager*            fFieldManager;
   G4ChordFinder*             fChordFinder;
   G4Mag_UsualEqRhs*          fEquation;  // Changed from G4EqMagElectricField
-  G4MagneticField*           fMagneticField;
+  LimitedRegionField*        fMagneticField;
   G4MagIntegratorStepper*    fStepper;
-  G4VIntegrationDriver*      fIntgrDriver;
+  G4GenericMessenger*        fMessenger;
   
+  G4String                   fStepperType;
+  G4String                   fDriverType;
   G4double                   fMinStep;
+  G4double                   fDeltaChord;
 };
 
-#endif
\ No newline at end of file
+#endif
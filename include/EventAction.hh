@@ -3,46 +3,56 @@
 
 #include "G4UserEventAction.hh"
 #include "globals.hh"
+#include "RunStatistics.hh"
+
+class RunAction;
+class G4HCofThisEvent;
 
 class EventAction : public G4UserEventAction
 {
 public:
-  EventAction();
+  EventAction(RunAction* runAction);
   virtual ~EventAction();
   
   // These virtual methods must be declared here 
   virtual void BeginOfEventAction(const G4Event*);
   virtual void EndOfEventAction(const G4Event*);
 
-  // Method to add energy deposit
-  void AddEdep(G4double edep) { fEdep += edep; }
+  // ID of the event being processed
+  G4int GetEventID() const { return fEventID; }
+
+  // Energy deposit in the tungsten block (valid at end of event)
   G4double GetEdep() const { return fEdep; }
   
-  // Methods for detector 1
-  void AddMuonAtDetector1() { fMuonsAtDetector1++; }
-  void AddPionAtDetector1() { fPionsAtDetector1++; }
-  G4int GetMuonsAtDetector1() const { return fMuonsAtDetector1; }
-  G4int GetPionsAtDetector1() const { return fPionsAtDetector1; }
-  
-  // Methods for detector 2 (10m counter)
-  void AddMuonAtDetector2() { fMuonsAtDetector2++; }
-  void AddPionAtDetector2() { fPionsAtDetector2++; }
-  G4int GetMuonsAtDetector2() const { return fMuonsAtDetector2; }
-  G4int GetPionsAtDetector2() const { return fPionsAtDetector2; }
-
+  // Count a muon/pion produced or seen at a detector in this event (energy in MeV)
+  void Count(RunStatistics::Location location, ParticleClassifier::Species species,
+             G4double weight, G4double kineticEnergy)
+  {
+    fTally.Add(location, species, weight, kineticEnergy);
+  }
 
 private:
-  G4double fEdep;  // Energy deposit
-  
-  // Counters for detector 1
-  G4int fMuonsAtDetector1;
-  G4int fPionsAtDetector1;
-  
-  // Counters for detector 2 (10m counter)
-  G4int fMuonsAtDetector2;
-  G4int fPionsAtDetector2;
+  // Tally the detector hits of the event (HitArena) and pass them on
+  // to the hit file in one go
+  void ProcessDetectorHits();
+
+  // Forward the particles leaving the tungsten to the phase-space file
+  void ProcessTungstenExits(G4HCofThisEvent* hce);
 
+  // Muons (mu+ and mu-) or charged pions at a location in this event
+  G4double GetMuons(RunStatistics::Location location) const;
+  G4double GetPions(RunStatistics::Location location) const;
 
+  RunAction* fRunAction;
+  G4int fEventID;
+  G4double fEdep;  // Energy deposit
+
+  // Hits collection IDs, looked up on the first event
+  G4int fTungstenHCID;
+  G4int fTungstenExitsHCID;
+  
+  // Per-event counts, added to the run statistics at end of event
+  RunStatistics::EventTally fTally;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,53 @@
+#ifndef Histograms_h
+#define Histograms_h 1
+
+#include "globals.hh"
+#include "ParticleClassifier.hh"
+
+class G4GenericMessenger;
+struct HitRecord;
+
+// In-memory histograms (G4AnalysisManager), merged over the threads at the
+// end of each run and written by the master to <prefix><runID>.<type>:
+//   0-7   kinetic energy at detector 1 (0-3) and 2 (4-7) for mu+, mu-, pi+, pi-
+//   8, 9  radial position of the hits at detector 1 and 2
+//   10    z of the pi+- decay vertices
+//   11    energy deposit in the tungsten per event
+// All are filled with the track weight. Change the binning with
+// /analysis/h1/set <id> <nbins> <min> <max> <unit>.
+class Histograms
+{
+  public:
+    static const G4int kNumberOfHitSpecies = ParticleClassifier::kPionZero;  // mu+- pi+-
+
+    static G4int GetEnergyID(G4int detectorID, ParticleClassifier::Species species)
+    {
+      return (detectorID - 1)*kNumberOfHitSpecies + species;
+    }
+    static G4int GetRadiusID(G4int detectorID) { return 2*kNumberOfHitSpecies + detectorID - 1; }
+    static const G4int kPionDecayZ = 2*kNumberOfHitSpecies + 2;
+    static const G4int kTungstenEdep = kPionDecayZ + 1;
+
+    static G4bool IsEnabled() { return fgEnabled; }
+
+    // Every thread, once (run action constructor)
+    static void Book();
+
+    // Every thread, at the start and end of each run
+    static void OpenFile(G4int runID);
+    static void WriteFile();
+
+    static void FillHit(const HitRecord& hit);
+    static void FillPionDecay(G4double z, G4double weight);
+    static void FillTungstenEdep(G4double edep);
+
+    // Creates the /tungsten/histo/ commands; call once on the master
+    static G4GenericMessenger* CreateMessenger();
+
+  private:
+    static G4bool fgEnabled;
+    static G4String fgOutputPrefix;
+    static G4String fgFileType;
+};
+
+#endif
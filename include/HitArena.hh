@@ -0,0 +1,68 @@
+#ifndef HitArena_h
+#define HitArena_h 1
+
+#include "HitRecord.hh"
+#include "globals.hh"
+
+#include <vector>
+
+#ifdef TUNGSTEN_COUNT_ALLOCATIONS
+#include "AllocationCounter.hh"
+#endif
+
+// Per-thread buffer of the detector hits of the current event. The
+// detector SDs append to it, EventAction hands the whole event to the
+// output at end of event, and the next event starts by resetting the size.
+// The memory is kept, so once it has grown to the busiest event the hit
+// path does not allocate.
+class HitArena
+{
+  public:
+    // One arena per thread
+    static HitArena* Instance();
+
+    // Start of run: clear the per-run statistics (the memory is kept)
+    void BeginOfRun();
+    // Start of event: drop the previous event's hits
+    void Reset();
+
+    void Add(const HitRecord& record)
+    {
+#ifdef TUNGSTEN_COUNT_ALLOCATIONS
+      AllocationCounter::Scope scope(GetAllocationSink());
+#endif
+      if (fRecords.size() == fRecords.capacity()) ++fGrowths;
+      fRecords.push_back(record);
+    }
+
+    const HitRecord* GetRecords() const { return fRecords.data(); }
+    std::size_t GetSize() const { return fRecords.size(); }
+    const HitRecord* begin() const { return fRecords.data(); }
+    const HitRecord* end() const { return fRecords.data() + fRecords.size(); }
+
+    // Reallocations of the buffer in the current run
+    std::size_t GetGrowths() const { return fGrowths; }
+
+    // Allocations in the hit path are only counted after the first event
+    // of the thread, which sizes the buffers
+    std::size_t& GetAllocationSink()
+    {
+      return fEvents > 1 ? fAllocations : fWarmUpAllocations;
+    }
+
+    // Hits per event, buffer growths and (if counted) hit-path allocations
+    // of this thread in the current run
+    void PrintReport() const;
+
+  private:
+    HitArena();
+
+    std::vector<HitRecord> fRecords;
+    std::size_t fMaxSize;             // busiest event of the run
+    std::size_t fGrowths;             // reallocations of fRecords in the run
+    G4long fEvents;                   // events seen by this thread, all runs
+    std::size_t fAllocations;         // hit-path allocations after the first event
+    std::size_t fWarmUpAllocations;
+};
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef HitFileReader_h
+#define HitFileReader_h 1
+
+#include "HitRecord.hh"
+#include "globals.hh"
+
+#include <fstream>
+#include <vector>
+
+// Reads back the block-columnar files written by HitWriter
+class HitFileReader
+{
+  public:
+    HitFileReader() = default;
+
+    G4bool Open(const G4String& fileName);
+    void Close() { fFile.close(); }
+
+    // Replace the contents of records with the next block; false at end of file
+    G4bool ReadBlock(std::vector<HitRecord>& records);
+
+  private:
+    std::ifstream fFile;
+    std::vector<char> fColumns;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef HitRecord_h
+#define HitRecord_h 1
+
+#include "globals.hh"
+#include <cstdint>
+
+// One muon/pion crossing of a detector. Plain data, so it can be copied
+// into the writer's fixed-size buffers without any allocation.
+struct HitRecord
+{
+  G4int   eventID;
+  G4int   species;        // ParticleClassifier::Species
+  G4int   detectorID;     // 1 or 2
+  G4float kineticEnergy;  // MeV
+  G4float position[3];    // mm
+  G4float direction[3];   // unit vector
+  G4float weight;         // statistical weight (1 without biasing)
+  std::uint8_t parentSpecies;  // species of the decayed pion, kOther if not from a pion decay
+  G4float decayZ;         // mm, z of that pion decay (0 if none)
+  G4int   creatorProcess; // G4ProcessSubType of the creator process, -1 for primaries
+};
+
+// Binary hit file layout (native byte order):
+//   header : 8-byte magic, uint32 version
+//   blocks : uint32 n, then one column per field, n entries each:
+//            int32 eventID, uint8 species, uint8 detectorID, float kineticEnergy,
+//            float x, y, z, float dx, dy, dz, float weight,
+//            uint8 parentSpecies, float decayZ, int16 creatorProcess
+// Readers only accept kVersion.
+namespace HitFileFormat
+{
+  const char kMagic[8] = { 'T', 'W', 'H', 'I', 'T', 'S', '\0', '\0' };
+  const std::uint32_t kVersion = 4;
+}
+
+#endif
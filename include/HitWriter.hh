@@ -0,0 +1,78 @@
+#ifndef HitWriter_h
+#define HitWriter_h 1
+
+#include "HitRecord.hh"
+#include "globals.hh"
+
+#include <condition_variable>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Buffered binary hit output. The calling thread only copies records into
+// a fixed-size block; full blocks are handed to a background thread that
+// converts them to columns and writes them to disk. The event loop only
+// waits if all blocks are queued for the disk, and handing a block over
+// never allocates.
+class HitWriter
+{
+  public:
+    static const std::size_t kBlockSize = 4096;  // records per block
+    static const std::size_t kNofBlocks = 8;     // blocks per writer
+
+    HitWriter();
+    ~HitWriter();
+
+    G4bool Open(const G4String& fileName);
+    // Flush the last partial block and wait for the writer thread
+    void Close();
+    G4bool IsOpen() const { return fCurrent != nullptr; }
+
+    // Merge per-thread hit files into one file ordered by event ID.
+    // Each input must already be in event order (true for a worker's shard).
+    static G4bool MergeFiles(const std::vector<G4String>& inputs,
+                             const G4String& output);
+
+    void Write(const HitRecord& record)
+    {
+      if (!fCurrent) return;
+      fCurrent->records[fCurrent->size++] = record;
+      if (fCurrent->size == kBlockSize) Submit();
+    }
+
+    // Queue the hits of a whole event (see HitArena)
+    void Write(const HitRecord* records, std::size_t n);
+
+  private:
+    struct Block {
+      std::size_t size = 0;
+      HitRecord records[kBlockSize];
+    };
+
+    void Submit();
+    void Run();
+    void WriteBlock(const Block& block);
+
+    std::ofstream fFile;
+    std::thread fThread;
+    std::mutex fMutex;
+    std::condition_variable fCondition;      // a block is full, or closing
+    std::condition_variable fFreeCondition;  // a block was written
+
+    std::unique_ptr<Block> fBlocks[kNofBlocks];  // owns all blocks
+    // Fixed-size queues of block pointers; each block is in exactly one
+    // of them, is fCurrent, or is being written
+    Block* fFullBlocks[kNofBlocks];  // ring, oldest at fFirstFull
+    std::size_t fFirstFull;
+    std::size_t fNofFull;
+    Block* fFreeBlocks[kNofBlocks];
+    std::size_t fNofFree;
+    Block* fCurrent;
+    G4bool fDone;
+
+    std::vector<char> fColumns;  // writer thread scratch buffer
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef LimitedRegionField_h
+#define LimitedRegionField_h 1
+
+#include "G4MagneticField.hh"
+#include "G4SystemOfUnits.hh"
+#include "globals.hh"
+
+// Solenoid parameters, owned by DetectorConstruction and shared by the
+// field objects of all threads. Changed on the master between runs only.
+struct FieldParameters
+{
+  G4double bz = 7.0*CLHEP::tesla;
+  G4double zMin = -5.0*CLHEP::m;
+  G4double zMax = 10.0*CLHEP::m;
+};
+
+// Uniform solenoid field along +z, zero outside [zMin, zMax]
+class LimitedRegionField : public G4MagneticField
+{
+  public:
+    explicit LimitedRegionField(const FieldParameters& parameters)
+    : fParameters(parameters), fNumberOfCalls(0) {}
+
+    void GetFieldValue(const G4double point[4], G4double* field) const override
+    {
+      ++fNumberOfCalls;
+      // Pure magnetic field: the equation of motion only reads Bx, By, Bz.
+      // Select instead of branching on the region.
+      const G4bool inside = (point[2] >= fParameters.zMin) & (point[2] <= fParameters.zMax);
+      field[0] = 0.;
+      field[1] = 0.;
+      field[2] = inside ? fParameters.bz : 0.;
+    }
+
+    G4double GetFieldValue() const { return fParameters.bz; }
+    G4double GetZMin() const { return fParameters.zMin; }
+    G4double GetZMax() const { return fParameters.zMax; }
+
+    // Evaluations since the last reset (the field object is per thread)
+    G4long GetNumberOfCalls() const { return fNumberOfCalls; }
+    void ResetNumberOfCalls() { fNumberOfCalls = 0; }
+
+  private:
+    const FieldParameters& fParameters;
+    mutable G4long fNumberOfCalls;
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef Logger_h
+#define Logger_h 1
+
+#include "globals.hh"
+
+class G4GenericMessenger;
+
+// Verbosity levels for the simulation's own console output.
+// The runtime level is set with /tungsten/verbose; anything above
+// TUNGSTEN_MAX_LOG_LEVEL (a CMake cache variable) is compiled out.
+class Logger
+{
+  public:
+    enum Level {
+      kQuiet = 0,  // errors only
+      kRun   = 1,  // setup messages and end-of-run summaries
+      kEvent = 2,  // one block per event
+      kStep  = 3   // every detector hit and pion decay
+    };
+
+    static G4int GetLevel() { return fgLevel; }
+    static void SetLevel(G4int level) { fgLevel = level; }
+
+    // Creates /tungsten/verbose; call once on the master
+    static G4GenericMessenger* CreateMessenger();
+
+  private:
+    static G4int fgLevel;
+};
+
+#ifndef TUNGSTEN_MAX_LOG_LEVEL
+#define TUNGSTEN_MAX_LOG_LEVEL 3
+#endif
+
+// The first comparison is a compile-time constant, so disabled levels
+// leave no code behind.
+#define TUNGSTEN_LOG_ENABLED(level) \
+  ((level) <= TUNGSTEN_MAX_LOG_LEVEL && (level) <= Logger::GetLevel())
+
+#define TUNGSTEN_LOG(level, message) \
+  do { \
+    if (TUNGSTEN_LOG_ENABLED(level)) { G4cout << message << G4endl; } \
+  } while (false)
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef MemoryUsage_h
+#define MemoryUsage_h 1
+
+#include "globals.hh"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <fstream>
+#endif
+
+// Process memory figures for the run summaries
+namespace MemoryUsage
+{
+  // Peak resident set size of the process in MB (0 if unavailable)
+  inline G4double GetPeakRSS()
+  {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+      return usage.ru_maxrss/(1024.*1024.);  // bytes
+#else
+      return usage.ru_maxrss/1024.;          // kilobytes
+#endif
+    }
+#endif
+    return 0.;
+  }
+
+  // Current resident set size of the process in MB (0 if unavailable)
+  inline G4double GetCurrentRSS()
+  {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    long pages = 0;
+    long resident = 0;
+    if (statm >> pages >> resident) {
+      return resident*(sysconf(_SC_PAGESIZE)/(1024.*1024.));
+    }
+#endif
+    return 0.;
+  }
+}
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef ParameterScan_h
+#define ParameterScan_h 1
+
+#include "globals.hh"
+#include "G4Timer.hh"
+#include <vector>
+
+class G4Run;
+class G4GenericMessenger;
+class RunStatistics;
+
+// Results of a design scan run in one process: a macro loops over the
+// /tungsten/geom/ and /tungsten/field/ settings with /control/foreach and
+// runs beamOn at each point (see scan.mac). With /tungsten/scan/output set,
+// the master appends one CSV row per run with the parameters and the muon
+// yields. It also times the setup before each run (initialization and
+// physics tables for the first one, the geometry update for the others),
+// so the summary can report the startup time the scan saved compared with
+// one process per point. Master only.
+class ParameterScan
+{
+  public:
+    // main(), as early as possible
+    static void StartJob();
+
+    // Master run action, at the start and end of each run
+    static void BeginOfRun(const G4Run* run);
+    static void EndOfRun(const G4Run* run, const RunStatistics& statistics,
+                         G4double runSeconds);
+
+    // main(), at the end of the job
+    static void PrintSummary();
+
+    // Creates the /tungsten/scan/ commands; call once on the master
+    static G4GenericMessenger* CreateMessenger();
+
+  private:
+    static void WriteRow(const G4Run* run, const RunStatistics& statistics,
+                         G4double runSeconds);
+
+    static G4String fgOutputFile;  // empty: no scan output
+    static G4Timer fgSetupTimer;   // since the job start or the last run
+    static G4double fgSetupTime;   // before the current run
+    static std::vector<G4double> fgSetupTimes;  // one per run with events
+};
+
+#endif
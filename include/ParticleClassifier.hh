@@ -0,0 +1,60 @@
+#ifndef ParticleClassifier_h
+#define ParticleClassifier_h 1
+
+#include "globals.hh"
+#include "G4ParticleDefinition.hh"
+#include <vector>
+
+class G4VProcess;
+
+// Maps particle definitions and processes onto the handful of species we
+// score. The tables are built once per run on each thread, so the stepping
+// code only does integer and pointer compares (no string copies).
+class ParticleClassifier
+{
+  public:
+    enum Species {
+      kMuonPlus = 0,
+      kMuonMinus,
+      kPionPlus,
+      kPionMinus,
+      kPionZero,
+      kOther
+    };
+    static const G4int kNumberOfSpecies = kOther;  // scored species only
+
+    // One classifier per thread
+    static ParticleClassifier* Instance();
+
+    // Rebuild the lookup tables (call at the start of each run)
+    void Build();
+
+    Species Classify(const G4ParticleDefinition* particle) const
+    {
+      const std::size_t id = particle->GetInstanceID();
+      return id < fSpeciesTable.size() ? fSpeciesTable[id] : kOther;
+    }
+
+    // True if the process is the decay process of the given species
+    G4bool IsDecay(Species species, const G4VProcess* process) const
+    {
+      return species != kOther && process != nullptr
+             && process == fDecayProcess[species];
+    }
+
+    static G4bool IsMuon(Species s) { return s == kMuonPlus || s == kMuonMinus; }
+    static G4bool IsChargedPion(Species s) { return s == kPionPlus || s == kPionMinus; }
+
+    // Particle name, e.g. "mu+"
+    static const G4String& GetName(Species species);
+    // Label used in the hit output, e.g. "mu+" for detector 1, "2mu+" for detector 2
+    static const G4String& GetHitLabel(G4int detectorID, Species species);
+
+  private:
+    ParticleClassifier();
+
+    std::vector<Species> fSpeciesTable;  // indexed by particle instance ID
+    const G4VProcess* fDecayProcess[kNumberOfSpecies];
+};
+
+#endif
@@ -0,0 +1,47 @@
+#ifndef PhaseSpace_h
+#define PhaseSpace_h 1
+
+#include "globals.hh"
+#include <atomic>
+
+class G4GenericMessenger;
+class PhaseSpaceReader;
+
+// Two-stage running, shared by all threads.
+// Stage 1 (/tungsten/phasespace/record true) writes every particle leaving
+// the tungsten block to <prefix><run>.phsp. Stage 2
+// (/tungsten/phasespace/replay <file>) replaces the proton gun: each event
+// takes the next stage-1 event from the memory-mapped file, and tracks that
+// re-enter the tungsten are killed because their exits are already in the
+// file.
+class PhaseSpace
+{
+  public:
+    static G4bool IsRecording() { return fgRecord; }
+    static const G4String& GetOutputPrefix() { return fgOutputPrefix; }
+    static G4double GetMinKineticEnergy() { return fgMinKineticEnergy; }
+
+    static G4bool IsReplaying() { return !fgReplayFile.empty() && fgReplayFile != "none"; }
+
+    // Master, at the start of each run: (re)open the replay file if it
+    // changed and rewind to its first event
+    static void PrepareReplay();
+    // Any thread: claim the next stage-1 event; false once the file is used up
+    static G4bool NextEvent(std::size_t& index);
+    static const PhaseSpaceReader* GetReader() { return fgReader; }
+
+    // Creates the /tungsten/phasespace/ commands; call once on the master
+    static G4GenericMessenger* CreateMessenger();
+
+  private:
+    static G4bool fgRecord;
+    static G4String fgOutputPrefix;
+    static G4double fgMinKineticEnergy;
+
+    static G4String fgReplayFile;
+    static PhaseSpaceReader* fgReader;
+    static G4String fgOpenFile;  // file behind fgReader
+    static std::atomic<std::size_t> fgNextEvent;
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef PhaseSpaceHit_h
+#define PhaseSpaceHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "PhaseSpaceRecord.hh"
+
+// A particle leaving the tungsten block (stage-1 recording only)
+class PhaseSpaceHit : public G4VHit
+{
+  public:
+    PhaseSpaceHit() = default;
+    explicit PhaseSpaceHit(const PhaseSpaceRecord& record) : fRecord(record) {}
+    ~PhaseSpaceHit() override = default;
+
+    inline void* operator new(size_t);
+    inline void operator delete(void* hit);
+
+    void Print() override;
+
+    const PhaseSpaceRecord& GetRecord() const { return fRecord; }
+
+  private:
+    PhaseSpaceRecord fRecord;
+};
+
+using PhaseSpaceHitsCollection = G4THitsCollection<PhaseSpaceHit>;
+
+extern G4ThreadLocal G4Allocator<PhaseSpaceHit>* PhaseSpaceHitAllocator;
+
+inline void* PhaseSpaceHit::operator new(size_t)
+{
+  if (!PhaseSpaceHitAllocator) PhaseSpaceHitAllocator = new G4Allocator<PhaseSpaceHit>;
+  return (void*)PhaseSpaceHitAllocator->MallocSingle();
+}
+
+inline void PhaseSpaceHit::operator delete(void* hit)
+{
+  PhaseSpaceHitAllocator->FreeSingle((PhaseSpaceHit*)hit);
+}
+
+#endif
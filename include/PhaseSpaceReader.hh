@@ -0,0 +1,42 @@
+#ifndef PhaseSpaceReader_h
+#define PhaseSpaceReader_h 1
+
+#include "PhaseSpaceRecord.hh"
+#include "globals.hh"
+
+#include <vector>
+
+// Read-only memory map of a phase-space file with an index of its events.
+// After Open() the reader is immutable, so all threads can share it.
+class PhaseSpaceReader
+{
+  public:
+    PhaseSpaceReader();
+    ~PhaseSpaceReader();
+
+    G4bool Open(const G4String& fileName);
+    void Close();
+    G4bool IsOpen() const { return fRecords != nullptr; }
+
+    std::size_t GetNumberOfEvents() const { return fEventStarts.size(); }
+    std::size_t GetNumberOfRecords() const { return fNumberOfRecords; }
+
+    // Rows of one event; n is set to their number
+    const PhaseSpaceRecord* GetEvent(std::size_t index, std::size_t& n) const
+    {
+      const std::size_t begin = fEventStarts[index];
+      const std::size_t end = index + 1 < fEventStarts.size()
+                              ? fEventStarts[index + 1] : fNumberOfRecords;
+      n = end - begin;
+      return fRecords + begin;
+    }
+
+  private:
+    void* fMapping;
+    std::size_t fMappingSize;
+    const PhaseSpaceRecord* fRecords;
+    std::size_t fNumberOfRecords;
+    std::vector<std::size_t> fEventStarts;  // first row of each event
+};
+
+#endif
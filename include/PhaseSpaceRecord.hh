@@ -0,0 +1,31 @@
+#ifndef PhaseSpaceRecord_h
+#define PhaseSpaceRecord_h 1
+
+#include "globals.hh"
+#include <cstdint>
+
+// One particle leaving the tungsten block. Fixed-size, padding-free rows,
+// so the replay can use the memory-mapped file directly.
+struct PhaseSpaceRecord
+{
+  std::int32_t eventID;
+  std::int32_t pdgCode;        // 0: placeholder for an event without exits
+  G4float      kineticEnergy;  // MeV
+  G4float      position[3];    // mm, world frame
+  G4float      direction[3];   // unit vector
+  G4float      weight;
+};
+
+static_assert(sizeof(PhaseSpaceRecord) == 40, "PhaseSpaceRecord must have no padding");
+
+// Phase-space file layout (native byte order):
+//   header : 8-byte magic, uint32 version
+//   records: PhaseSpaceRecord rows; the rows of one event are contiguous
+namespace PhaseSpaceFormat
+{
+  const char kMagic[8] = { 'T', 'W', 'P', 'H', 'S', 'P', '\0', '\0' };
+  const std::uint32_t kVersion = 1;
+  const std::size_t kHeaderSize = sizeof(kMagic) + sizeof(kVersion);
+}
+
+#endif
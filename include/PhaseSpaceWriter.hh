@@ -0,0 +1,41 @@
+#ifndef PhaseSpaceWriter_h
+#define PhaseSpaceWriter_h 1
+
+#include "PhaseSpaceRecord.hh"
+#include "globals.hh"
+
+#include <fstream>
+#include <vector>
+
+// Buffered writer of the stage-1 phase-space files (one per thread)
+class PhaseSpaceWriter
+{
+  public:
+    static const std::size_t kBufferSize = 4096;  // records per write
+
+    PhaseSpaceWriter();
+    ~PhaseSpaceWriter();
+
+    G4bool Open(const G4String& fileName);
+    void Close();
+    G4bool IsOpen() const { return fFile.is_open(); }
+
+    void Write(const PhaseSpaceRecord& record)
+    {
+      fBuffer.push_back(record);
+      if (fBuffer.size() == kBufferSize) Flush();
+    }
+
+    // Append the records of the per-thread files to one output file. Events
+    // stay contiguous, so no sorting is needed for the replay.
+    static G4bool Concatenate(const std::vector<G4String>& inputs,
+                              const G4String& output);
+
+  private:
+    void Flush();
+
+    std::ofstream fFile;
+    std::vector<PhaseSpaceRecord> fBuffer;
+};
+
+#endif
@@ -4,13 +4,63 @@
 #include "G4VModularPhysicsList.hh"
 #include "globals.hh"
 
+class G4GenericMessenger;
+
+// FTFP_BERT-based list with selectable profiles:
+//   full       - every constructor (default)
+//   production - drops EM extra, radioactive decay, ion and stopping physics
+//   fast       - production with G4EmStandardPhysics_option1 and no hadron elastic
+// Choose with --physics or /tungsten/physics/profile before /run/initialize.
 class PhysicsList : public G4VModularPhysicsList
 {
 public:
-  PhysicsList();
+  enum Profile { kFull = 0, kProduction, kFast };
+
+  PhysicsList(const G4String& profile = "full");
   virtual ~PhysicsList();
 
   virtual void SetCuts();
+
+  // Only leaner profiles can follow once the list is built
+  void SetProfile(const G4String& name);
+
+  // Scale the in-flight decay rate of charged pions by factor (> 1) in the
+  // solenoid envelope; the first call registers G4GenericBiasingPhysics
+  void SetPionDecayBias(G4double factor);
+  static G4bool ParseProfile(const G4String& name, Profile& profile);
+
+  // Physics-table cache: tables are stored under <directory>/<key>, where
+  // the key is a hash of the Geant4 version, the registered constructors
+  // and the range cuts, and retrieved by later jobs with the same key.
+  // Empty directory (the default): always build the tables.
+  void SetCacheDirectory(const G4String& directory) { fCacheDirectory = directory; }
+  // Master, once the tables are built: store them on a cache miss
+  void StoreTableCache();
+
+private:
+  void DefineCommands();
+  // Master, from SetCuts: look the configuration up in the cache
+  void SetUpTableCache();
+  G4String GetConfigurationDescription() const;
+  // Current range cut of the Tungsten region (the default cut without one)
+  G4double GetTungstenCutValue() const;
+
+  Profile fProfile;
+
+  // Constructors a profile may remove
+  G4VPhysicsConstructor* fEmExtraPhysics;
+  G4VPhysicsConstructor* fRadioactiveDecayPhysics;
+  G4VPhysicsConstructor* fHadronElasticPhysics;
+  G4VPhysicsConstructor* fStoppingPhysics;
+  G4VPhysicsConstructor* fIonPhysics;
+
+  G4VPhysicsConstructor* fBiasingPhysics;  // nullptr until biasing is requested
+
+  G4String fCacheDirectory;
+  G4String fCachePath;      // <directory>/<key> of this configuration
+  G4bool fStoreCache;       // tables not in the cache yet
+
+  G4GenericMessenger* fMessenger;
 };
 
 #endif
\ No newline at end of file
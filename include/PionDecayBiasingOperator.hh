@@ -0,0 +1,50 @@
+#ifndef PionDecayBiasingOperator_h
+#define PionDecayBiasingOperator_h 1
+
+#include "G4VBiasingOperator.hh"
+#include "globals.hh"
+#include <map>
+
+class G4BOptnChangeCrossSection;
+class G4ParticleDefinition;
+
+// Scales the in-flight decay cross section of pi+ and pi- by a constant
+// factor in the volume it is attached to (the solenoid envelope between
+// the target and the detectors), after Geant4's GB01 example. Decays
+// happen sooner and the tracks pick up the matching weights, so weighted
+// yields stay unbiased. Needs G4GenericBiasingPhysics on the pion "Decay"
+// process (PhysicsList::SetPionDecayBias); one operator per thread.
+class PionDecayBiasingOperator : public G4VBiasingOperator
+{
+  public:
+    PionDecayBiasingOperator();
+    ~PionDecayBiasingOperator() override;
+
+    void StartRun() override;
+
+    // Factor shared by all threads; 1 means no biasing
+    static void SetDecayFactor(G4double factor) { fgDecayFactor = factor; }
+    static G4double GetDecayFactor() { return fgDecayFactor; }
+
+  private:
+    G4VBiasingOperation* ProposeOccurenceBiasingOperation(
+      const G4Track* track, const G4BiasingProcessInterface* callingProcess) override;
+    G4VBiasingOperation* ProposeFinalStateBiasingOperation(
+      const G4Track*, const G4BiasingProcessInterface*) override { return nullptr; }
+    G4VBiasingOperation* ProposeNonPhysicsBiasingOperation(
+      const G4Track*, const G4BiasingProcessInterface*) override { return nullptr; }
+
+    void OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                          G4BiasingAppliedCase biasingCase,
+                          G4VBiasingOperation* occurenceOperationApplied,
+                          G4double weightForOccurenceInteraction,
+                          G4VBiasingOperation* finalStateOperationApplied,
+                          const G4VParticleChange* particleChangeProduced) override;
+
+    // One operation per wrapped decay process (pi+ and pi-)
+    std::map<const G4BiasingProcessInterface*, G4BOptnChangeCrossSection*> fOperations;
+
+    static G4double fgDecayFactor;
+};
+
+#endif
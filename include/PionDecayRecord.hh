@@ -0,0 +1,32 @@
+#ifndef PionDecayRecord_h
+#define PionDecayRecord_h 1
+
+#include "globals.hh"
+#include <cstdint>
+
+// One charged pion decaying into a muon. Fixed-size, padding-free rows, like
+// the phase-space records, so the file can be read with a single fread.
+struct PionDecayRecord
+{
+  std::int32_t eventID;
+  std::int32_t pionSpecies;   // ParticleClassifier::Species of the parent
+  std::int32_t muonSpecies;   // ParticleClassifier::Species of the muon
+  G4float      pionEnergy;    // MeV, kinetic energy at the decay
+  G4float      muonEnergy;    // MeV, kinetic energy at production
+  G4float      position[3];   // mm, decay vertex in the world frame
+  G4float      weight;        // statistical weight of the muon
+};
+
+static_assert(sizeof(PionDecayRecord) == 36, "PionDecayRecord must have no padding");
+
+// Decay file layout (native byte order):
+//   header : 8-byte magic, uint32 version
+//   records: PionDecayRecord rows; the rows of one event are contiguous
+namespace PionDecayFormat
+{
+  const char kMagic[8] = { 'T', 'W', 'D', 'E', 'C', 'A', 'Y', '\0' };
+  const std::uint32_t kVersion = 1;
+  const std::size_t kHeaderSize = sizeof(kMagic) + sizeof(kVersion);
+}
+
+#endif
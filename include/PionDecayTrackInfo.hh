@@ -0,0 +1,48 @@
+#ifndef PionDecayTrackInfo_h
+#define PionDecayTrackInfo_h 1
+
+#include "G4VUserTrackInformation.hh"
+#include "G4Allocator.hh"
+#include "globals.hh"
+
+// Attached to every muon from a charged-pion decay: where the parent decayed
+// and what it was. The detector SDs copy it into the hit record. Allocated
+// from a per-thread pool, so tagging the muons adds no heap traffic.
+class PionDecayTrackInfo : public G4VUserTrackInformation
+{
+  public:
+    PionDecayTrackInfo(G4int parentSpecies, G4double parentEnergy, G4double decayZ)
+    : fParentSpecies(parentSpecies), fParentEnergy(parentEnergy), fDecayZ(decayZ) {}
+    ~PionDecayTrackInfo() override = default;
+
+    inline void* operator new(size_t);
+    inline void operator delete(void* info);
+
+    void Print() const override;
+
+    G4int GetParentSpecies() const { return fParentSpecies; }  // ParticleClassifier::Species
+    G4double GetParentEnergy() const { return fParentEnergy; }
+    G4double GetDecayZ() const { return fDecayZ; }
+
+  private:
+    G4int fParentSpecies;
+    G4double fParentEnergy;
+    G4double fDecayZ;
+};
+
+extern G4ThreadLocal G4Allocator<PionDecayTrackInfo>* PionDecayTrackInfoAllocator;
+
+inline void* PionDecayTrackInfo::operator new(size_t)
+{
+  if (!PionDecayTrackInfoAllocator) {
+    PionDecayTrackInfoAllocator = new G4Allocator<PionDecayTrackInfo>;
+  }
+  return (void*)PionDecayTrackInfoAllocator->MallocSingle();
+}
+
+inline void PionDecayTrackInfo::operator delete(void* info)
+{
+  PionDecayTrackInfoAllocator->FreeSingle((PionDecayTrackInfo*)info);
+}
+
+#endif
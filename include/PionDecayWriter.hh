@@ -0,0 +1,41 @@
+#ifndef PionDecayWriter_h
+#define PionDecayWriter_h 1
+
+#include "PionDecayRecord.hh"
+#include "globals.hh"
+
+#include <fstream>
+#include <vector>
+
+// Buffered writer of the pion-decay vertex table (one file per thread)
+class PionDecayWriter
+{
+  public:
+    static const std::size_t kBufferSize = 4096;  // records per write
+
+    PionDecayWriter();
+    ~PionDecayWriter();
+
+    G4bool Open(const G4String& fileName);
+    void Close();
+    G4bool IsOpen() const { return fFile.is_open(); }
+
+    void Write(const PionDecayRecord& record)
+    {
+      if (!fFile.is_open()) return;
+      fBuffer.push_back(record);
+      if (fBuffer.size() == kBufferSize) Flush();
+    }
+
+    // Append the records of the per-thread files to one output file
+    static G4bool Concatenate(const std::vector<G4String>& inputs,
+                              const G4String& output);
+
+  private:
+    void Flush();
+
+    std::ofstream fFile;
+    std::vector<PionDecayRecord> fBuffer;
+};
+
+#endif
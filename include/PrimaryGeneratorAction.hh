@@ -16,6 +16,9 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
     virtual void GeneratePrimaries(G4Event*);
 
   private:
+    // Stage 2: primaries are the next stage-1 event of the phase-space file
+    void GenerateFromPhaseSpace(G4Event* event);
+
     G4ParticleGun* fParticleGun;
 };
 
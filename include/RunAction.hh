@@ -3,12 +3,19 @@
 
 #include "G4UserRunAction.hh"
 #include "globals.hh"
-#include "G4ThreeVector.hh"
+#include "G4Timer.hh"
+#include "HitWriter.hh"
+#include "PhaseSpaceWriter.hh"
+#include "PionDecayWriter.hh"
+#include "RunStatistics.hh"
+#include "StackingAction.hh"
 #include <map>
 #include <string>
-#include <fstream>
+#include <vector>
 
 class G4Run;
+class ElectricFieldSetup;
+class G4GenericMessenger;
 
 class RunAction : public G4UserRunAction
 {
@@ -18,25 +25,74 @@ class RunAction : public G4UserRunAction
 
     virtual void BeginOfRunAction(const G4Run*);
     virtual void EndOfRunAction(const G4Run*);
+
+    // Hit files are named <prefix><runID>.bin (default "particle_data")
+    static void SetOutputPrefix(const G4String& prefix) { fgOutputPrefix = prefix; }
+    // Raw per-hit output; off by default, the histograms cover the usual
+    // analysis with an output size independent of the statistics
+    static void SetWriteHits(G4bool value) { fgWriteHits = value; }
+    // Pion-decay table, <prefix>_decays<runID>.bin; off by default
+    static void SetWriteDecays(G4bool value) { fgWriteDecays = value; }
+    // Machine-readable run summary, <prefix><runID>.json; off by default
+    static void SetSummaryPrefix(const G4String& prefix) { fgSummaryPrefix = prefix; }
+
+    // Creates the /tungsten/output/ commands; call once on the master
+    static G4GenericMessenger* CreateMessenger();
     
     void AddSecondaryParticle(const G4String& name) { fSecondaryParticles[name]++; }
     
-    // Record particle data to Excel
-    void RecordParticleToExcel(const G4String& name, 
-                              const G4double& position);
+    // Queue the detector hits of an event for the binary hit file
+    void RecordHits(const HitRecord* hits, std::size_t n) { fHitWriter.Write(hits, n); }
+
+    // Queue a particle leaving the tungsten for the phase-space file
+    void RecordPhaseSpace(const PhaseSpaceRecord& record) { fPhaseSpaceWriter.Write(record); }
                               
-    // Count particle for summary
-    void CountParticle(const G4String& name) { fParticleCounts[name]++; }
-    void RecordPionDecay(const G4String& pionType, const G4String& muonType, 
-                    G4double pionEnergy, G4double muonEnergy,
-                    const G4ThreeVector& position);
+    // Add the muon/pion counts of a finished event to the run statistics
+    void AddEvent(const RunStatistics::EventTally& tally) { fStatistics.AddEvent(tally); }
 
+    // Step counter for the step-throughput report
+    void CountStep() { fNumberOfSteps++; }
 
+    // Track killed by the stacking policy
+    void CountKilledTrack(StackingAction::KillReason reason) { fKilledTracks.Add(reason); }
+
+    // Queue a pion -> muon decay for the decay table
+    void RecordPionDecay(const PionDecayRecord& record) { fDecayWriter.Write(record); }
 
   private:
+    static G4String HitFileName(G4int runID);
+    static G4String DecayFileName(G4int runID);
+    // Field setup of this thread, for the field-call counts
+    ElectricFieldSetup* GetFieldSetup() const;
+
+    // Master only: yields, energy moments, throughput and memory of the run
+    void WriteSummary(const G4Run* run, G4double seconds) const;
+
+    // Master only: merge the worker shards of this run into one file
+    void MergeHitFiles(G4int runID);
+    // Master only: concatenate the worker phase-space files of this run
+    void MergePhaseSpaceFiles(G4int runID);
+    // Master only: concatenate the worker decay tables of this run
+    void MergeDecayFiles(G4int runID);
+
     std::map<G4String, int> fSecondaryParticles;
-    std::map<G4String, int> fParticleCounts;  // For tracking all particles
-    std::ofstream fOutputFile;
+    HitWriter fHitWriter;
+    PhaseSpaceWriter fPhaseSpaceWriter;
+    PionDecayWriter fDecayWriter;
+    RunStatistics fStatistics;  // merged across threads for the summary
+    StackingAction::KillCounts fKilledTracks;
+
+    // Hit files written by the workers in this run, merged by the master
+    static std::vector<G4String> fgShardFiles;
+    static std::vector<G4String> fgPhaseSpaceShards;
+    static std::vector<G4String> fgDecayShards;
+    static G4String fgOutputPrefix;
+    static G4bool fgWriteHits;
+    static G4bool fgWriteDecays;
+    static G4String fgSummaryPrefix;
+
+    G4long fNumberOfSteps;
+    G4Timer fTimer;
     };
 
 #endif
\ No newline at end of file
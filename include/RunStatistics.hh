@@ -0,0 +1,91 @@
+#ifndef RunStatistics_h
+#define RunStatistics_h 1
+
+#include "G4VAccumulable.hh"
+#include "ParticleClassifier.hh"
+#include "globals.hh"
+
+#include <ostream>
+
+// Muon/pion tallies per (location, species), stored as fixed arrays and
+// registered with the G4AccumulableManager so the worker threads are merged
+// into the master at the end of each run. Tracks are counted with their
+// statistical weight (1 unless pion-decay biasing is on); per-event sums of
+// squares give the statistical error on the weighted yield per proton.
+// Weighted sums of the kinetic energy and its square give the mean and RMS
+// of each energy spectrum.
+class RunStatistics : public G4VAccumulable
+{
+  public:
+    enum Location {
+      kProduced = 0,  // created anywhere in the world
+      kDetector1,
+      kDetector2,
+      kNumberOfLocations
+    };
+
+    // Counts of a single event, filled by the stepping code
+    struct EventTally {
+      G4double counts[kNumberOfLocations][ParticleClassifier::kNumberOfSpecies];  // sum of weights
+      G4int entries[kNumberOfLocations][ParticleClassifier::kNumberOfSpecies];    // tracks
+      G4double energy[kNumberOfLocations][ParticleClassifier::kNumberOfSpecies];  // sum of w*E
+      G4double energySquares[kNumberOfLocations][ParticleClassifier::kNumberOfSpecies];
+
+      void Reset();
+      // Kinetic energy in MeV
+      void Add(Location location, ParticleClassifier::Species species, G4double weight,
+               G4double kineticEnergy)
+      {
+        counts[location][species] += weight;
+        entries[location][species]++;
+        energy[location][species] += weight*kineticEnergy;
+        energySquares[location][species] += weight*kineticEnergy*kineticEnergy;
+      }
+    };
+
+    RunStatistics();
+    ~RunStatistics() override = default;
+
+    void AddEvent(const EventTally& tally);
+
+    G4long GetNumberOfEvents() const { return fNumberOfEvents; }
+    // Sum of weights, and the number of tracks behind it
+    G4double GetTotal(Location location, ParticleClassifier::Species species) const
+    {
+      return fSum[location][species];
+    }
+    G4long GetEntries(Location location, ParticleClassifier::Species species) const
+    {
+      return fEntries[location][species];
+    }
+    // Mean count per event (i.e. per proton) and its statistical error
+    G4double GetYield(Location location, ParticleClassifier::Species species) const;
+    G4double GetYieldError(Location location, ParticleClassifier::Species species) const;
+    // Weighted mean kinetic energy (MeV), its error, the spectrum RMS and
+    // its error (normal approximation, from the number of tracks)
+    G4double GetMeanEnergy(Location location, ParticleClassifier::Species species) const;
+    G4double GetMeanEnergyError(Location location, ParticleClassifier::Species species) const;
+    G4double GetEnergyRMS(Location location, ParticleClassifier::Species species) const;
+    G4double GetEnergyRMSError(Location location, ParticleClassifier::Species species) const;
+
+    void Merge(const G4VAccumulable& other) override;
+    void Reset() override;
+
+    // Summary table, printed by the master
+    void PrintSummary() const;
+    // The same numbers as JSON members, one "<location>.<species>.<quantity>"
+    // key per line (no enclosing braces), for the run summary file
+    void WriteJson(std::ostream& out) const;
+
+    static const G4String& GetLocationName(Location location);
+
+  private:
+    G4long fNumberOfEvents;
+    G4double fSum[kNumberOfLocations][ParticleClassifier::kNumberOfSpecies];
+    G4double fSumSquares[kNumberOfLocations][ParticleClassifier::kNumberOfSpecies];
+    G4long fEntries[kNumberOfLocations][ParticleClassifier::kNumberOfSpecies];
+    G4double fEnergy[kNumberOfLocations][ParticleClassifier::kNumberOfSpecies];
+    G4double fEnergySquares[kNumberOfLocations][ParticleClassifier::kNumberOfSpecies];
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef StackingAction_h
+#define StackingAction_h 1
+
+#include "G4UserStackingAction.hh"
+#include "G4VAccumulable.hh"
+#include "globals.hh"
+
+class RunAction;
+class ParticleClassifier;
+class G4ParticleDefinition;
+class G4GenericMessenger;
+
+// Track-killing policy for the secondaries that cannot lead to a muon or
+// pion at the detectors: gammas, e+-, neutrons and nuclear fragments below
+// per-species kinetic energy thresholds, and other tracks outside the
+// forward acceptance cone. Muons and pions are never killed; they go to the
+// urgent stack and everything else waits until they are done. Off by
+// default; see /tungsten/stack/.
+class StackingAction : public G4UserStackingAction
+{
+  public:
+    enum KillReason {
+      kKilledGamma = 0,
+      kKilledElectron,   // e- and e+
+      kKilledNeutron,
+      kKilledFragment,   // deuterons, alphas and heavier ions
+      kKilledOutsideCone,
+      kNumberOfKillReasons
+    };
+
+    // Killed-track counts per reason, merged across threads by the RunAction
+    class KillCounts : public G4VAccumulable
+    {
+      public:
+        KillCounts();
+        ~KillCounts() override = default;
+
+        void Add(KillReason reason) { fCounts[reason]++; }
+        G4long Get(KillReason reason) const { return fCounts[reason]; }
+
+        void Merge(const G4VAccumulable& other) override;
+        void Reset() override;
+
+      private:
+        G4long fCounts[kNumberOfKillReasons];
+    };
+
+    // Settings shared by all threads
+    struct Policy {
+      G4bool   enabled;
+      G4double gammaThreshold;     // kinetic energy below which a track is killed
+      G4double electronThreshold;
+      G4double neutronThreshold;
+      G4double fragmentThreshold;
+      G4double maxAngle;           // acceptance cone half-angle around +z
+    };
+
+    StackingAction(RunAction* runAction);
+    virtual ~StackingAction();
+
+    virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+
+    static const Policy& GetPolicy() { return fgPolicy; }
+    static const G4String& GetKillReasonName(KillReason reason);
+
+    // Creates the /tungsten/stack/ commands; call once on the master
+    static G4GenericMessenger* CreateMessenger();
+
+  private:
+    G4ClassificationOfNewTrack Kill(KillReason reason);
+
+    RunAction* fRunAction;
+    const ParticleClassifier* fClassifier;
+    const G4ParticleDefinition* fGamma;
+    const G4ParticleDefinition* fElectron;
+    const G4ParticleDefinition* fPositron;
+    const G4ParticleDefinition* fNeutron;
+
+    static Policy fgPolicy;
+};
+
+#endif
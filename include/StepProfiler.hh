@@ -0,0 +1,92 @@
+#ifndef StepProfiler_h
+#define StepProfiler_h 1
+
+#include "G4SteppingVerbose.hh"
+#include "globals.hh"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class G4VProcess;
+class G4GenericMessenger;
+
+// Step profiler: step counts, track counts and wall time per (logical
+// volume, particle, process), accumulated in a table per thread and merged
+// at the end of each run. The master prints the top entries by time and
+// writes the whole table to <prefix><runID>.csv.
+//
+// It is a stepping verbose, so the stepping manager calls it around every
+// step, and it only exists when built with TUNGSTEN_STEP_PROFILER. Even
+// then it is idle (tracking verbose 0) until /tungsten/profile/enable true;
+// while profiling it raises the tracking verbose level to 1 on its thread
+// and keeps the verbose output silent.
+//
+// Steps are keyed by the volume they start in and the process that limited
+// them. Tracks are counted under the volume they start in and the process
+// that created them ("primary" for primaries).
+class StepProfiler : public G4SteppingVerbose
+{
+  public:
+    StepProfiler();
+    ~StepProfiler() override;
+
+    void NewStep() override;
+    void StepInfo() override;
+    void TrackingStarted() override;
+
+    // Every thread, from the run action
+    static void BeginOfRun();
+    static void EndOfRun();
+    // Master, after EndOfRun: print and write the merged table
+    static void Report(G4int runID);
+
+    // Creates the /tungsten/profile/ commands; call once on the master
+    static G4GenericMessenger* CreateMessenger();
+
+  private:
+    struct Key {
+      const G4LogicalVolume* volume;
+      const G4ParticleDefinition* particle;
+      const G4VProcess* process;
+      G4bool operator==(const Key& other) const
+      {
+        return volume == other.volume && particle == other.particle && process == other.process;
+      }
+    };
+    struct KeyHash {
+      std::size_t operator()(const Key& key) const
+      {
+        std::size_t hash = std::hash<const void*>()(key.volume);
+        hash = hash*31 + std::hash<const void*>()(key.particle);
+        return hash*31 + std::hash<const void*>()(key.process);
+      }
+    };
+
+  public:
+    struct Entry {
+      G4long steps = 0;
+      G4long tracks = 0;
+      std::chrono::nanoseconds::rep nanoseconds = 0;
+    };
+
+  private:
+    void Start();
+    void Stop();
+    void Merge();
+
+    G4bool fActive;
+    G4int fPreviousVerboseLevel;
+    std::chrono::steady_clock::time_point fStepStart;
+    std::unordered_map<Key, Entry, KeyHash> fTable;
+
+    static G4ThreadLocal StepProfiler* fgInstance;
+    static G4bool fgEnabled;
+    static G4int fgTopN;
+    static G4String fgOutputPrefix;
+};
+
+#endif
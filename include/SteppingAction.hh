@@ -3,49 +3,24 @@
 
 #include "G4UserSteppingAction.hh"
 #include "globals.hh"
-#include <map>
-#include <vector>
-#include "G4ThreeVector.hh"
 
 class EventAction;
-class G4LogicalVolume;
-
-// Struct to store particle information
-struct ParticleInfo {
-  G4String type;
-  G4double energy;
-  G4ThreeVector position;
-  G4ThreeVector direction;
-  G4int detectorID;
-  G4String process;
-};
+class RunAction;
 
+// Step-level diagnostics: the step counter of the throughput report.
+// Not registered when TUNGSTEN_STEPPING_ACTION is off.
 class SteppingAction : public G4UserSteppingAction
 {
 public:
-  SteppingAction(EventAction* eventAction);
+  SteppingAction(RunAction* runAction, EventAction* eventAction);
   virtual ~SteppingAction();
   
   // Method called for each step
   virtual void UserSteppingAction(const G4Step*);
   
 private:
+  RunAction* fRunAction;
   EventAction* fEventAction;
-  G4LogicalVolume* fScoringVolume;
-  G4LogicalVolume* fDetector1Volume;
-  G4LogicalVolume* fDetector2Volume;
-  
-  G4LogicalVolume* fCounterVolume;  // Add this for the 10m detector
-  
-  // Maps to count particles at each detector
-  std::map<G4String, G4int> fParticleCounter;
-  std::map<G4String, G4int> fDetector1Particles;
-  std::map<G4String, G4int> fDetector2Particles;
-
-  std::map<G4String, G4int> fCounter10mParticles;
-  
-  // Store detected particle information
-  std::vector<ParticleInfo> fDetectedParticles;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef Telemetry_h
+#define Telemetry_h 1
+
+#include "globals.hh"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+class G4GenericMessenger;
+
+// Live progress of long runs. Every thread counts its events, tracks and
+// steps and histograms its event wall times in a slot of its own (relaxed
+// atomics, no locks on the event loop). While a run is going on, a sampler
+// thread on the master reads all slots every /tungsten/telemetry/interval
+// seconds and prints one status line: events done, events/s, ETA, event
+// time p50/p99, tracks and steps per event, RSS, and the least and most
+// loaded thread. It also writes the same data, with the per-thread counts,
+// to a JSON file. Interval 0 (the default) switches it off.
+class Telemetry
+{
+  public:
+    static G4bool IsEnabled() { return fgInterval > 0.; }
+
+    // Every thread, at the start of a run: clear this thread's slot
+    static void BeginOfRun();
+    // Master: start and stop the sampler thread
+    static void StartSampling(G4int runID, G4int nofEvents);
+    static void StopSampling();
+
+    // Event loop hooks (no-ops while disabled)
+    static void BeginOfEvent()
+    {
+      if (IsEnabled()) GetSlot().eventStart = std::chrono::steady_clock::now();
+    }
+    static void EndOfEvent();
+    static void CountTrack(G4int nofSteps)
+    {
+      if (!IsEnabled()) return;
+      Slot& slot = GetSlot();
+      slot.tracks.fetch_add(1, std::memory_order_relaxed);
+      slot.steps.fetch_add(nofSteps, std::memory_order_relaxed);
+    }
+
+    // Creates the /tungsten/telemetry/ commands; call once on the master
+    static G4GenericMessenger* CreateMessenger();
+
+  private:
+    // Event times in 8 bins per factor of 2, from 1 us up
+    static const G4int kBinsPerOctave = 8;
+    static const G4int kNumberOfTimeBins = 40*kBinsPerOctave;
+
+    struct Slot {
+      G4int threadID = 0;
+      std::atomic<G4long> events{0};
+      std::atomic<G4long> tracks{0};
+      std::atomic<G4long> steps{0};
+      std::array<std::atomic<G4long>, kNumberOfTimeBins> eventTimes{};
+      std::chrono::steady_clock::time_point eventStart;  // owner thread only
+    };
+
+    static Slot& GetSlot();
+    // All slots ever created. A slot lives as long as the process, so the
+    // sampler can keep reading it after its thread has gone.
+    static std::vector<std::unique_ptr<Slot>>& GetSlots();
+    static void Sample(G4double elapsed, G4double interval);
+
+    static G4double fgInterval;  // seconds
+    static G4String fgFileName;
+};
+
+#endif
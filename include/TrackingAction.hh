@@ -0,0 +1,32 @@
+#ifndef TrackingAction_h
+#define TrackingAction_h 1
+
+#include "G4UserTrackingAction.hh"
+#include "globals.hh"
+
+class EventAction;
+class RunAction;
+class ParticleClassifier;
+
+// Counts the muons and pions produced in each event, once per track,
+// records where the charged pions decay (histogram, decay table and the
+// origin tag on their muons), and feeds the telemetry
+class TrackingAction : public G4UserTrackingAction
+{
+  public:
+    TrackingAction(RunAction* runAction, EventAction* eventAction);
+    virtual ~TrackingAction();
+
+    virtual void PreUserTrackingAction(const G4Track*);
+    virtual void PostUserTrackingAction(const G4Track*);
+
+  private:
+    // Tag the muons of a decayed charged pion and add them to the decay table
+    void RecordDecay(const G4Track* pion, const G4Step* step);
+
+    RunAction* fRunAction;
+    EventAction* fEventAction;
+    const ParticleClassifier* fClassifier;
+};
+
+#endif
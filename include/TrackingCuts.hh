@@ -0,0 +1,31 @@
+#ifndef TrackingCuts_h
+#define TrackingCuts_h 1
+
+#include "G4UserLimits.hh"
+#include "globals.hh"
+
+class G4GenericMessenger;
+
+// Kinetic-energy tracking thresholds for gammas, e+- and neutrons, applied
+// by G4UserSpecialCuts in every volume this is attached to. Muons, pions
+// and all other particles are never cut. Thresholds of 0 switch a species
+// off; set them with /tungsten/cuts/.
+class TrackingCuts : public G4UserLimits
+{
+  public:
+    TrackingCuts();
+    ~TrackingCuts() override;
+
+    G4double GetUserMinEkine(const G4Track& track) override;
+
+  private:
+    void DefineCommands();
+
+    G4double fGammaMinEkine;
+    G4double fElectronMinEkine;
+    G4double fNeutronMinEkine;
+
+    G4GenericMessenger* fMessenger;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef TungstenHit_h
+#define TungstenHit_h 1
+
+#include "G4VHit.hh"
+#include "G4THitsCollection.hh"
+#include "G4Allocator.hh"
+#include "globals.hh"
+
+// Energy deposited in the tungsten block during one event. The collection
+// holds a single hit that TungstenSD adds every step to.
+class TungstenHit : public G4VHit
+{
+  public:
+    TungstenHit() = default;
+    ~TungstenHit() override = default;
+
+    inline void* operator new(size_t);
+    inline void operator delete(void* hit);
+
+    void Print() override;
+
+    void AddEdep(G4double edep) { fEdep += edep; }
+    G4double GetEdep() const { return fEdep; }
+
+  private:
+    G4double fEdep = 0.;
+};
+
+using TungstenHitsCollection = G4THitsCollection<TungstenHit>;
+
+extern G4ThreadLocal G4Allocator<TungstenHit>* TungstenHitAllocator;
+
+inline void* TungstenHit::operator new(size_t)
+{
+  if (!TungstenHitAllocator) TungstenHitAllocator = new G4Allocator<TungstenHit>;
+  return (void*)TungstenHitAllocator->MallocSingle();
+}
+
+inline void TungstenHit::operator delete(void* hit)
+{
+  TungstenHitAllocator->FreeSingle((TungstenHit*)hit);
+}
+
+#endif
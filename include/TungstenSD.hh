@@ -0,0 +1,39 @@
+#ifndef TungstenSD_h
+#define TungstenSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "TungstenHit.hh"
+#include "PhaseSpaceHit.hh"
+
+// Sensitive detector of the tungsten block: sums the energy deposit of
+// the event into a single hit. When a phase-space file is being recorded
+// it also collects every particle leaving the block; when one is being
+// replayed it kills the tracks that enter it.
+class TungstenSD : public G4VSensitiveDetector
+{
+  public:
+    TungstenSD(const G4String& name, const G4String& hitsCollectionName,
+               const G4String& exitsCollectionName);
+    ~TungstenSD() override = default;
+
+    void Initialize(G4HCofThisEvent* hce) override;
+    G4bool ProcessHits(G4Step* step, G4TouchableHistory* history) override;
+    void EndOfEvent(G4HCofThisEvent* hce) override;
+
+  private:
+    void RecordExit(const G4Step* step);
+
+    G4int fCollectionID;
+    G4int fExitsCollectionID;
+    TungstenHit* fHit;  // owned by the collection
+    PhaseSpaceHitsCollection* fExits;
+
+    // Phase-space mode of the current event
+    G4bool fRecordExits;
+    G4bool fKillEntering;
+    G4double fMinKineticEnergy;
+    G4int fEventID;
+    std::size_t fExitsCapacity;  // largest exits collection so far
+};
+
+#endif
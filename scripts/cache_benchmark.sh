@@ -0,0 +1,46 @@
+#!/usr/bin/env bash
+# Physics-table cache benchmark for tungsten_sim.
+#
+# Runs bench_cache.mac three times: without the cache, with an empty cache
+# directory (cold: tables built and stored) and again with the filled one
+# (warm: tables retrieved). For each it prints the setup time before the
+# first run (kernel initialization and physics tables) and the job time.
+#
+# Usage: cache_benchmark.sh [tungsten_sim] [threads] [profile]
+#   defaults: ./tungsten_sim $(nproc) full
+
+set -euo pipefail
+
+SIM=${1:-./tungsten_sim}
+THREADS=${2:-$(nproc)}
+PROFILE=${3:-full}
+CACHE=$(mktemp -d)
+trap 'rm -rf "$CACHE"' EXIT
+
+printf "%-8s %10s %10s  %s\n" mode "setup [s]" "job [s]" tables
+
+run() {
+  local mode=$1; shift
+  local log
+  log=$(mktemp)
+  "$SIM" --physics "$PROFILE" -t "$THREADS" -m bench_cache.mac "$@" > "$log" 2>&1
+  rm -f particle_data0.bin
+
+  # "Setup before run 0: <s> s" and "Job: <s> s wall time, ..."
+  local setup job tables
+  setup=$(sed -nE 's/^Setup before run 0: ([0-9.eE+-]+) s$/\1/p' "$log" | head -n 1)
+  job=$(sed -nE 's/^Job: ([0-9.eE+-]+) s.*/\1/p' "$log" | tail -n 1)
+  tables=$(grep -oE '^Physics tables: (retrieving|stored|not cached)' "$log" \
+           | tail -n 1 | cut -d' ' -f3 || true)
+  if [[ -z "$setup" || -z "$job" ]]; then
+    echo "no timing for the $mode run, see $log" >&2
+    exit 1
+  fi
+  rm -f "$log"
+
+  printf "%-8s %10.2f %10.2f  %s\n" "$mode" "$setup" "$job" "${tables:-built}"
+}
+
+run none
+run cold --physics-cache "$CACHE"
+run warm --physics-cache "$CACHE"
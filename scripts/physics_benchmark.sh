@@ -0,0 +1,57 @@
+#!/usr/bin/env bash
+# Physics-profile benchmark for tungsten_sim.
+#
+# For each profile (full, production, fast) measures the startup time and
+# memory (bench_startup.mac: initialization and physics tables only) and the
+# event rate and peak RSS of the fixed-seed bench.mac workload, next to the
+# muon yield per proton (mu+ + mu-) at both detectors.
+#
+# Usage: physics_benchmark.sh [tungsten_sim] [threads] [profiles...]
+#   defaults: ./tungsten_sim $(nproc) full production fast
+
+set -euo pipefail
+
+SIM=${1:-./tungsten_sim}
+THREADS=${2:-$(nproc)}
+shift $(( $# > 2 ? 2 : $# ))
+PROFILES=("$@")
+[[ ${#PROFILES[@]} -eq 0 ]] && PROFILES=(full production fast)
+
+printf "%-11s %10s %10s %10s %10s %20s %20s\n" profile "start [s]" "start [MB]" \
+       "events/s" "run [MB]" "D1 mu/proton" "D2 mu/proton"
+
+for profile in "${PROFILES[@]}"; do
+  log=$(mktemp)
+
+  # "Job: <s> s wall time, peak RSS <mb> MB"
+  "$SIM" --physics "$profile" -t "$THREADS" -m bench_startup.mac > "$log" 2>&1
+  job=$(grep -E '^Job: ' "$log" | tail -n 1 || true)
+  if [[ -z "$job" ]]; then
+    echo "no job summary for profile $profile, see $log" >&2
+    exit 1
+  fi
+  start_s=$(sed -E 's/^Job: ([0-9.eE+-]+) s.*/\1/' <<< "$job")
+  start_mb=$(sed -E 's/.*peak RSS ([0-9.eE+-]+) MB.*/\1/' <<< "$job")
+
+  "$SIM" --physics "$profile" -t "$THREADS" -m bench.mac -o "physics_${profile}_" \
+         > "$log" 2>&1
+  rm -f physics_"${profile}"_*.bin
+
+  # Run line, then the MUON/PION SUMMARY rows "Detector N mu+ total yield error"
+  read -r rate run_mb d1 d2 < <(awk '
+    /^Run [0-9]+: .* events\/s\), peak RSS/ {
+      rate = $0; sub(/.*\(/, "", rate); sub(/ events\/s\).*/, "", rate)
+      rss = $0; sub(/.*peak RSS /, "", rss); sub(/ MB.*/, "", rss)
+    }
+    /^ *Detector [12] +mu[+-] / {
+      y[$2] += $5; e2[$2] += $6*$6
+    }
+    END {
+      printf "%s %s %.4g+-%.2g %.4g+-%.2g\n", rate, rss,
+             y[1], sqrt(e2[1]), y[2], sqrt(e2[2])
+    }' "$log")
+  rm -f "$log"
+
+  printf "%-11s %10.2f %10.0f %10.2f %10.0f %20s %20s\n" "$profile" "$start_s" \
+         "$start_mb" "$rate" "$run_mb" "$d1" "$d2"
+done
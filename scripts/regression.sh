@@ -0,0 +1,129 @@
+#!/usr/bin/env bash
+# Fixed-seed physics and performance regression check for tungsten_sim.
+#
+# Runs regression.mac once with the serial run manager and once in MT mode
+# (or only the modes given) and keeps each run summary as
+# regression_<mode>.json in the working directory (events/s and peak RSS
+# included, for comparisons across commits). It then compares the muon/pion
+# yields, mean energies and energy RMS at both detectors with the
+# references in <reference dir>/<mode>.json. A quantity fails when it is
+# more than SIGMA combined standard errors away from the reference. Serial
+# and MT runs use different random streams, so they are compared with their
+# own references.
+#
+# Throughput and memory are only reported, since they depend on the
+# machine. Set MIN_SPEED (e.g. 0.7) to also fail when events/s drop below
+# that fraction of the reference.
+#
+# With --update the references are replaced by this build's results.
+# Commit them after checking the run by hand.
+#
+# Exit code 0 if all compared quantities agree, 1 on a failure or a
+# missing reference.
+#
+# Usage: regression.sh [tungsten_sim] [reference dir] [serial] [mt] [--update]
+#   defaults: ./tungsten_sim regression, both modes; MT threads: THREADS
+#   (default 4), SIGMA (default 4)
+
+set -euo pipefail
+
+SIM=${1:-./tungsten_sim}
+REFERENCES=${2:-regression}
+THREADS=${THREADS:-4}
+SIGMA=${SIGMA:-4}
+MIN_SPEED=${MIN_SPEED:-0}
+
+UPDATE=
+MODES=()
+for arg in "${@:3}"; do
+  case "$arg" in
+    --update) UPDATE=--update ;;
+    serial|mt) MODES+=("$arg") ;;
+    *) echo "Unknown argument $arg" >&2; exit 1 ;;
+  esac
+done
+[[ ${#MODES[@]} -gt 0 ]] || MODES=(serial mt)
+
+status=0
+
+run() {
+  local mode=$1; shift
+  local log
+  log=$(mktemp)
+  rm -f regression0.json
+  if ! "$SIM" -m regression.mac "$@" > "$log" 2>&1 || [[ ! -f regression0.json ]]; then
+    echo "$mode: no run summary, see $log" >&2
+    exit 1
+  fi
+  rm -f "$log"
+  mv regression0.json "regression_$mode.json"
+}
+
+compare() {
+  local mode=$1
+  local result="regression_$mode.json" reference="$REFERENCES/$mode.json"
+
+  if [[ "$UPDATE" == "--update" ]]; then
+    mkdir -p "$REFERENCES"
+    cp "$result" "$reference"
+    echo "$mode: reference $reference updated"
+    return
+  fi
+  if [[ ! -f "$reference" ]]; then
+    echo "$mode: no reference $reference (create it with --update)" >&2
+    status=1
+    return
+  fi
+
+  echo "$mode ($result against $reference):"
+  # Both files hold one "key": value member per line
+  awk -v sigma="$SIGMA" -v minSpeed="$MIN_SPEED" '
+    function parse(line, kv) {
+      if (!match(line, /"[^"]+": [-+0-9.eE]+/)) return 0
+      kv[1] = substr(line, RSTART + 1, RLENGTH - 1); sub(/".*/, "", kv[1])
+      kv[2] = substr(line, RSTART, RLENGTH); sub(/.*: /, "", kv[2])
+      return 1
+    }
+    function check(name, value, error, refValue, refError,    combined, pull, verdict) {
+      combined = sqrt(error*error + refError*refError)
+      pull = combined > 0 ? (value - refValue)/combined : (value == refValue ? 0 : 1e9)
+      verdict = (pull > sigma || pull < -sigma) ? "FAIL" : "ok"
+      if (verdict == "FAIL") failed = 1
+      printf "  %-32s %12.6g %12.6g %8.2f  %s\n", name, value, refValue, pull, verdict
+    }
+    NR == FNR { if (parse($0, kv)) ref[kv[1]] = kv[2]; next }
+    { if (parse($0, kv)) { cur[kv[1]] = kv[2]; keys[++n] = kv[1] } }
+    END {
+      printf "  %-32s %12s %12s %8s\n", "quantity", "this build", "reference", "pull"
+      for (i = 1; i <= n; ++i) {
+        key = keys[i]
+        if (key !~ /^detector[12]\..*\.(yield|mean_energy_mev|rms_energy_mev)$/) continue
+        # yield -> yield_error, <x>_energy_mev -> <x>_energy_error_mev
+        errorKey = key
+        if (!sub(/yield$/, "yield_error", errorKey)) sub(/_mev$/, "_error_mev", errorKey)
+        check(key, cur[key], cur[errorKey], ref[key], ref[errorKey])
+      }
+      speed = ref["events_per_s"] > 0 ? cur["events_per_s"]/ref["events_per_s"] : 0
+      printf "  events/s %.2f (reference %.2f, ratio %.2f), peak RSS %s MB (reference %s MB)\n",
+             cur["events_per_s"], ref["events_per_s"], speed,
+             cur["peak_rss_mb"], ref["peak_rss_mb"]
+      if (minSpeed > 0 && speed < minSpeed) {
+        printf "  FAIL: events/s below %.2f of the reference\n", minSpeed
+        failed = 1
+      }
+      exit failed
+    }
+  ' "$reference" "$result" || status=1
+}
+
+for mode in "${MODES[@]}"; do
+  case "$mode" in
+    serial) run serial --runmanager serial -t 1 ;;
+    mt) run mt --runmanager mt -t "$THREADS" ;;
+  esac
+done
+for mode in "${MODES[@]}"; do
+  compare "$mode"
+done
+
+exit $status
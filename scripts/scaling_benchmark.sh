@@ -0,0 +1,44 @@
+#!/usr/bin/env bash
+# Thread-scaling benchmark for tungsten_sim.
+#
+# Runs the same fixed-seed workload with 1, 2, 4, ... threads (up to the
+# number of cores, which is always included) and prints events/s, parallel
+# efficiency and peak RSS for each configuration.
+#
+# Usage: scaling_benchmark.sh [tungsten_sim] [macro] [runmanager] [max threads]
+#   defaults: ./tungsten_sim bench.mac mt $(nproc)
+
+set -euo pipefail
+
+SIM=${1:-./tungsten_sim}
+MACRO=${2:-bench.mac}
+RUNMANAGER=${3:-mt}
+MAX_THREADS=${4:-$(nproc)}
+
+threads=()
+for ((t = 1; t < MAX_THREADS; t *= 2)); do threads+=("$t"); done
+threads+=("$MAX_THREADS")
+
+printf "%8s %12s %12s %12s %12s\n" threads "events/s" speedup efficiency "RSS [MB]"
+
+base_rate=""
+for t in "${threads[@]}"; do
+  log=$(mktemp)
+  # Default output (no raw hit files), as in production runs
+  "$SIM" --runmanager "$RUNMANAGER" -t "$t" -s 12345 -m "$MACRO" > "$log" 2>&1
+
+  # "Run N: <events> events in <s> s (<rate> events/s), peak RSS <mb> MB"
+  line=$(grep -E '^Run [0-9]+: .* events/s\), peak RSS' "$log" | tail -n 1 || true)
+  if [[ -z "$line" ]]; then
+    echo "no run summary for $t threads, see $log" >&2
+    exit 1
+  fi
+  rate=$(sed -E 's/.*\(([0-9.eE+-]+) events\/s\).*/\1/' <<< "$line")
+  rss=$(sed -E 's/.*peak RSS ([0-9.eE+-]+) MB.*/\1/' <<< "$line")
+  rm -f "$log"
+
+  [[ -z "$base_rate" ]] && base_rate=$rate
+  speedup=$(awk -v r="$rate" -v b="$base_rate" 'BEGIN { printf "%.2f", r/b }')
+  efficiency=$(awk -v s="$speedup" -v t="$t" 'BEGIN { printf "%.1f%%", 100*s/t }')
+  printf "%8d %12.2f %12s %12s %12.0f\n" "$t" "$rate" "$speedup" "$efficiency" "$rss"
+done
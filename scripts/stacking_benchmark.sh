@@ -0,0 +1,43 @@
+#!/usr/bin/env bash
+# Stacking-policy benchmark for tungsten_sim.
+#
+# Runs bench_stacking.mac (fixed seeds; policy off, then on with and without
+# the angular cut) and prints the speedup of each run over the first one
+# next to the muon/pion yields per proton at both detectors. A policy is
+# safe when the yields agree within their errors. Works the same for any
+# macro made of fixed-seed runs, e.g. bench_cuts.mac.
+#
+# Usage: stacking_benchmark.sh [tungsten_sim] [macro] [threads]
+#   defaults: ./tungsten_sim bench_stacking.mac $(nproc)
+
+set -euo pipefail
+
+SIM=${1:-./tungsten_sim}
+MACRO=${2:-bench_stacking.mac}
+THREADS=${3:-$(nproc)}
+
+log=$(mktemp)
+"$SIM" -t "$THREADS" -m "$MACRO" -o stacking_ > "$log" 2>&1
+rm -f stacking_*.bin
+
+# Master lines only: "Run N: <events> events in <s> s (<rate> events/s), ..."
+# followed by the MUON/PION SUMMARY table of that run
+awk '
+  /^Run [0-9]+: .* events\/s\)/ {
+    run = $2; sub(":", "", run)
+    rate = $0; sub(/.*\(/, "", rate); sub(/ events\/s\).*/, "", rate)
+    if (base == "") base = rate
+    printf "\nRun %s: %.2f events/s, speedup %.2f\n", run, rate, rate/base
+    printf "%12s %8s %14s %14s\n", "Location", "Type", "Per proton", "Error"
+  }
+  /^ *Detector [12] / {
+    printf "%12s %8s %14s %14s\n", $1 " " $2, $3, $5, $6
+  }
+  /^Tracks killed by the stacking policy/ { print }
+' "$log"
+
+if ! grep -qE '^Run [0-9]+: ' "$log"; then
+  echo "no run summary found, see $log" >&2
+  exit 1
+fi
+rm -f "$log"
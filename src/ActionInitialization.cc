@@ -2,14 +2,47 @@
 #include "PrimaryGeneratorAction.hh"
 #include "RunAction.hh"
 #include "EventAction.hh"
+#include "TrackingAction.hh"
+#include "StackingAction.hh"
 #include "SteppingAction.hh"
+#include "Logger.hh"
+#include "PhaseSpace.hh"
+#include "ParameterScan.hh"
+#include "Histograms.hh"
+#include "Telemetry.hh"
+#ifdef TUNGSTEN_STEP_PROFILER
+#include "StepProfiler.hh"
+#endif
+
+#include "G4GenericMessenger.hh"
 
 ActionInitialization::ActionInitialization()
- : G4VUserActionInitialization()
-{}
+ : G4VUserActionInitialization(),
+   fLoggerMessenger(Logger::CreateMessenger()),
+   fStackingMessenger(StackingAction::CreateMessenger()),
+   fPhaseSpaceMessenger(PhaseSpace::CreateMessenger()),
+   fScanMessenger(ParameterScan::CreateMessenger()),
+   fOutputMessenger(RunAction::CreateMessenger()),
+   fHistogramMessenger(Histograms::CreateMessenger()),
+   fTelemetryMessenger(Telemetry::CreateMessenger()),
+   fProfilerMessenger(nullptr)
+{
+#ifdef TUNGSTEN_STEP_PROFILER
+  fProfilerMessenger = StepProfiler::CreateMessenger();
+#endif
+}
 
 ActionInitialization::~ActionInitialization()
-{}
+{
+  delete fLoggerMessenger;
+  delete fStackingMessenger;
+  delete fPhaseSpaceMessenger;
+  delete fScanMessenger;
+  delete fOutputMessenger;
+  delete fHistogramMessenger;
+  delete fTelemetryMessenger;
+  delete fProfilerMessenger;
+}
 
 void ActionInitialization::BuildForMaster() const
 {
@@ -26,13 +59,27 @@ void ActionInitialization::Build() const
   SetUserAction(runAction);
   
   // Create and set EventAction
-  EventAction* eventAction = new EventAction();
+  EventAction* eventAction = new EventAction(runAction);
   SetUserAction(eventAction);
   
-  // Create and set SteppingAction
-  SteppingAction* steppingAction = new SteppingAction(eventAction);
+  // Production counts, once per track
+  SetUserAction(new TrackingAction(runAction, eventAction));
+
+  // Track-killing policy (inactive until /tungsten/stack/enable true)
+  SetUserAction(new StackingAction(runAction));
+
+  // Detector scoring is done by the sensitive detectors; the stepping
+  // action only adds diagnostics and can be compiled out for production
+#ifdef TUNGSTEN_STEPPING_ACTION
+  SteppingAction* steppingAction = new SteppingAction(runAction, eventAction);
   SetUserAction(steppingAction);
-  
-  // Connect stepping action to event action
-  //eventAction->SetSteppingAction(steppingAction);
-}
\ No newline at end of file
+#endif
+}
+
+#ifdef TUNGSTEN_STEP_PROFILER
+G4VSteppingVerbose* ActionInitialization::InitializeSteppingVerbose() const
+{
+  // One per thread; idle until /tungsten/profile/enable true
+  return new StepProfiler();
+}
+#endif
@@ -0,0 +1,48 @@
+#include "AllocationCounter.hh"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+  thread_local std::size_t allocations = 0;
+}
+
+std::size_t AllocationCounter::Get()
+{
+  return allocations;
+}
+
+// Replacements of the global allocation functions. The nothrow and array
+// forms of the standard library forward to these.
+void* operator new(std::size_t size)
+{
+  ++allocations;
+  if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+  std::free(pointer);
+}
@@ -9,18 +9,60 @@
 #include "G4SystemOfUnits.hh"
 #include "G4VisAttributes.hh"
 #include "G4VPhysicalVolume.hh"
+#include "G4AutoDelete.hh"
+#include "G4PhysicalVolumeStore.hh"
+#include "G4GeometryManager.hh"
+#include "G4GenericMessenger.hh"
+#include "G4SDManager.hh"
+#include "G4Region.hh"
+#include "G4ProductionCuts.hh"
+#include "TrackingCuts.hh"
 #include "ElectricFieldSetup.hh"
+#include "DetectorSD.hh"
+#include "TungstenSD.hh"
+#include "PionDecayBiasingOperator.hh"
+#include "Logger.hh"
+#include "G4UnitsTable.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
 
 DetectorConstruction::DetectorConstruction()
 : G4VUserDetectorConstruction(),
   fScoringVolume(nullptr),
   fDetector1Volume(nullptr),
-  fDetector2Volume(nullptr)
+  fDetector2Volume(nullptr),
+  fFieldVolume(nullptr),
+  fTungstenWidth(5*cm),
+  fTungstenLength(75*cm),
+  fTungstenZ(50*cm),
+  fDetector1Distance(10*cm),
+  fDetector2Distance(500*cm),
+  fDetectorRadius(75*cm),
+  fDetectorThickness(0.1*cm),
+  fFieldRadius(2.0*m),
+  fEnvelopeSolid(nullptr),
+  fTungstenSolid(nullptr),
+  fDetector1Solid(nullptr),
+  fDetector2Solid(nullptr),
+  fEnvelopePlacement(nullptr),
+  fTungstenPlacement(nullptr),
+  fDetector1Placement(nullptr),
+  fDetector2Placement(nullptr),
+  fCheckOverlaps(true),
+  fTrackingCuts(new TrackingCuts()),
+  fMessenger(nullptr),
+  fFieldMessenger(nullptr)
 {
+  DefineCommands();
 }
 
 DetectorConstruction::~DetectorConstruction()
 {
+  delete fMessenger;
+  delete fFieldMessenger;
+  delete fTrackingCuts;
 }
 
 G4VPhysicalVolume* DetectorConstruction::Construct()
@@ -40,18 +82,10 @@ G4VPhysicalVolume* DetectorConstruction::Construct()
   // World volume parameters
   G4double world_size = 10000*cm;
 
-  // Tungsten block parameters - 10×10×30 cm
-  G4double tungsten_x = 5*cm;
-  G4double tungsten_y = 5*cm; 
-  G4double tungsten_z = 75*cm;
-  
-  // Detector parameters - circular discs with 30 cm diameter and 1 cm thickness
-  G4double detector_radius = 75*cm;  // 30 cm diameter
-  G4double detector_thickness = 0.1*cm;
-  
-  // Detector positions (distance from the end of the tungsten block)
-  G4double detector1_position = tungsten_z/2 + 60*cm;  // 10 cm from tungsten
-  G4double detector2_position = tungsten_z/2 + 550*cm; // m from the block
+  // The sizes and positions of everything inside the world are set by
+  // UpdateGeometry() from the /tungsten/geom/ and /tungsten/field/region/
+  // parameters, here and whenever one of them changes between runs. The
+  // placements are therefore created at the origin and checked afterwards.
 
   // World volume - cylindrical
 G4double world_radius = 0.5*world_size;  // Radius matching the box half-width
@@ -76,78 +110,85 @@ G4VPhysicalVolume* physWorld =
                     nullptr,               // its mother volume
                     false,                 // no boolean operation
                     0,                     // copy number
-                    true);                 // checking overlaps
+                    fCheckOverlaps);       // checking overlaps
+
+  // Solenoid envelope: the field lives only in here, through a local field
+  // manager, so tracks in the rest of the world use straight-line transport.
+  // Daughters are positioned relative to its centre.
+  fEnvelopeSolid =
+    new G4Tubs("FieldRegion", 0, fFieldRadius, 1*m, 0*deg, 360*deg);
+
+  G4LogicalVolume* logicEnvelope =
+    new G4LogicalVolume(fEnvelopeSolid, world_mat, "FieldRegion");
+
+  fEnvelopePlacement =
+    new G4PVPlacement(nullptr,                  // no rotation
+                      G4ThreeVector(),          // spans the field zMin..zMax
+                      logicEnvelope,            // its logical volume
+                      "FieldRegion",            // its name
+                      logicWorld,               // its mother volume
+                      false,                    // no boolean operation
+                      0);                       // copy number
 
   // Tungsten block
-  G4Box* solidTungsten = 
-    new G4Box("Tungsten", 0.5*tungsten_x, 0.5*tungsten_y, 0.5*tungsten_z);
+  fTungstenSolid = new G4Box("Tungsten", 1*cm, 1*cm, 1*cm);
   
   G4LogicalVolume* logicTungsten = 
-    new G4LogicalVolume(solidTungsten, tungsten_mat, "Tungsten");
+    new G4LogicalVolume(fTungstenSolid, tungsten_mat, "Tungsten");
   
-  new G4PVPlacement(nullptr,                // no rotation
-                    G4ThreeVector(0, 0, 500), // at (0,0,0)
-                    logicTungsten,          // its logical volume
-                    "Tungsten",             // its name
-                    logicWorld,             // its mother volume
-                    false,                  // no boolean operation
-                    0,                      // copy number
-                    true);                  // checking overlaps
+  fTungstenPlacement =
+    new G4PVPlacement(nullptr,                // no rotation
+                      G4ThreeVector(),        // at (0,0,fTungstenZ) in the world
+                      logicTungsten,          // its logical volume
+                      "Tungsten",             // its name
+                      logicEnvelope,          // its mother volume
+                      false,                  // no boolean operation
+                      0);                     // copy number
 
   // Create circular detectors (discs)
-  G4Tubs* solidDetector1 = 
+  fDetector1Solid = 
     new G4Tubs("Detector1", 
               0*cm,                   // inner radius
-              detector_radius,        // outer radius
-              0.5*detector_thickness, // half-length in z
+              1*cm,                   // outer radius
+              1*cm,                   // half-length in z
               0*deg,                  // start angle
-              360*deg);              // spanning angle             // spanning angle
+              360*deg);               // spanning angle
   
-  // Detector 1 (2 cm from tungsten)
+  // Detector 1 (10 cm downstream of the tungsten by default)
   G4LogicalVolume* logicDetector1 = 
-    new G4LogicalVolume(solidDetector1, scintillator_mat, "Detector1");
+    new G4LogicalVolume(fDetector1Solid, scintillator_mat, "Detector1");
   
-  new G4PVPlacement(nullptr,                // no rotation
-                    G4ThreeVector(0, 0, detector1_position), // position
-                    logicDetector1,         // its logical volume
-                    "Detector1",            // its name
-                    logicWorld,             // its mother volume
-                    false,                  // no boolean operation
-                    0,                      // copy number
-                    true);                  // checking overlaps
+  fDetector1Placement =
+    new G4PVPlacement(nullptr,                // no rotation
+                      G4ThreeVector(),        // position
+                      logicDetector1,         // its logical volume
+                      "Detector1",            // its name
+                      logicEnvelope,          // its mother volume
+                      false,                  // no boolean operation
+                      0);                     // copy number
   
-  G4Tubs* solidDetector2 = 
+  fDetector2Solid = 
     new G4Tubs("Detector2", 
               0*cm,                   // inner radius
-              detector_radius,        // outer radius
-              0.5*detector_thickness, // half-length in z
+              1*cm,                   // outer radius
+              1*cm,                   // half-length in z
               0*deg,                  // start angle
-              360*deg);              // spanning angle             // spanning angle
-  G4ThreeVector detector1Pos = G4ThreeVector(0, 0, detector1_position);
-  new G4PVPlacement(nullptr, detector1Pos, logicDetector1, "Detector1", logicWorld, false, 0, true);
-  fDetector1Position = detector1Pos;
+              360*deg);               // spanning angle
 
-
-
-  // Detector 2 (10 m from tungsten)
+  // Detector 2 (5 m downstream of the tungsten by default)
   G4LogicalVolume* logicDetector2 = 
-    new G4LogicalVolume(solidDetector2, scintillator_mat, "Detector2");
-  
-  new G4PVPlacement(nullptr,                // no rotation
-                    G4ThreeVector(0, 0, detector2_position), // position
-                    logicDetector2,         // its logical volume
-                    "Detector2",            // its name
-                    logicWorld,             // its mother volume
-                    false,                  // no boolean operation
-                    0,                      // copy number
-                    true);                  // checking overlaps
+    new G4LogicalVolume(fDetector2Solid, scintillator_mat, "Detector2");
   
-  
-
-  G4ThreeVector detector2Pos = G4ThreeVector(0, 0, detector2_position);
-  new G4PVPlacement(nullptr, detector2Pos, logicDetector2, "Detector2", logicWorld, false, 0, true);
-  fDetector2Position = detector2Pos;
+  fDetector2Placement =
+    new G4PVPlacement(nullptr,                // no rotation
+                      G4ThreeVector(),        // position
+                      logicDetector2,         // its logical volume
+                      "Detector2",            // its name
+                      logicEnvelope,          // its mother volume
+                      false,                  // no boolean operation
+                      0);                     // copy number
 
+  UpdateGeometry();
 
   // Visual attributes
   G4VisAttributes* tungsten_vis_att = new G4VisAttributes(G4Colour(0.5, 0.5, 0.5)); // Grey
@@ -158,20 +199,39 @@ G4VPhysicalVolume* physWorld =
   logicDetector1->SetVisAttributes(detector1_vis_att);
 
   G4VisAttributes* detector2_vis_att = new G4VisAttributes(G4Colour(0.0, 0.0, 1.0)); // Blue
-  detector1_vis_att->SetVisibility(true);
-  logicDetector1->SetVisAttributes(detector2_vis_att);
+  detector2_vis_att->SetVisibility(true);
+  logicDetector2->SetVisAttributes(detector2_vis_att);
   
   // Make the world volume transparent
   G4VisAttributes* world_vis_att = new G4VisAttributes(G4Colour(1.5, 1.5, 1.5, 1.0)); // Transparent
   world_vis_att->SetVisibility(true);
   world_vis_att->SetForceWireframe(true);
   logicWorld->SetVisAttributes(world_vis_att);
+  logicEnvelope->SetVisAttributes(G4VisAttributes::GetInvisible());
+
+  // Fine production cuts only in the target; the air and the detectors
+  // stay in the coarse default region. The region and its cuts are shared
+  // by all threads and created once, here on the master; change the value
+  // with /run/setCutForRegion Tungsten <value>.
+  G4Region* tungstenRegion = new G4Region("Tungsten");
+  tungstenRegion->AddRootLogicalVolume(logicTungsten);
+  auto* tungstenCuts = new G4ProductionCuts();
+  tungstenCuts->SetProductionCut(0.7*mm);
+  tungstenRegion->SetProductionCuts(tungstenCuts);
+
+  // Kinetic-energy tracking thresholds (G4UserSpecialCuts). User limits
+  // are not inherited by daughters, so every volume gets them.
+  for (G4LogicalVolume* volume : { logicWorld, logicEnvelope, logicTungsten,
+                                   logicDetector1, logicDetector2 }) {
+    volume->SetUserLimits(fTrackingCuts);
+  }
 
   // In DetectorConstruction::Construct()
   // Set scoring volumes
   fScoringVolume = logicTungsten;
   fDetector1Volume = logicDetector1;
   fDetector2Volume = logicDetector2;
+  fFieldVolume = logicEnvelope;
 
   return physWorld;
 }
@@ -180,14 +240,290 @@ G4VPhysicalVolume* physWorld =
 
 void DetectorConstruction::ConstructSDandField()
 {
-  // Create global magnetic field
-  if (!fElectricFieldSetup) {
-    fElectricFieldSetup = new ElectricFieldSetup();
-    G4ThreeVector fieldValue = G4ThreeVector(0.0, 0.0, 7.0*tesla);
-    fElectricFieldSetup->SetMagneticField(fieldValue);
-    
-    G4cout << "\n-----------------------------------------------------------" << G4endl;
-    G4cout << " Global Magnetic Field Set to: 0, 0, 7 Tesla" << G4endl;
-    G4cout << "-----------------------------------------------------------\n" << G4endl;
+  // Sensitive detectors (one set per thread). Only steps inside these
+  // volumes reach the scoring code.
+  G4SDManager* sdManager = G4SDManager::GetSDMpointer();
+
+  auto* detector1SD = new DetectorSD("Detector1SD", 1);
+  sdManager->AddNewDetector(detector1SD);
+  SetSensitiveDetector(fDetector1Volume, detector1SD);
+
+  auto* detector2SD = new DetectorSD("Detector2SD", 2);
+  sdManager->AddNewDetector(detector2SD);
+  SetSensitiveDetector(fDetector2Volume, detector2SD);
+
+  auto* tungstenSD = new TungstenSD("TungstenSD", "TungstenHits", "TungstenExits");
+  sdManager->AddNewDetector(tungstenSD);
+  SetSensitiveDetector(fScoringVolume, tungstenSD);
+
+  // Create the solenoid field (one setup per thread)
+  if (!fElectricFieldSetup.Get()) {
+    // Value and extent are read from fField, so later changes reach
+    // every thread without rebuilding the setup
+    ElectricFieldSetup* fieldSetup = new ElectricFieldSetup(fField);
+    G4AutoDelete::Register(fieldSetup);
+    fElectricFieldSetup.Put(fieldSetup);
+  }
+
+  // Pion-decay biasing in the envelope air only (daughters have their own
+  // logical volumes and stay analog). Operators are thread-local.
+  if (PionDecayBiasingOperator::GetDecayFactor() > 1.) {
+    auto* biasingOperator = new PionDecayBiasingOperator();
+    biasingOperator->AttachTo(fFieldVolume);
+    G4AutoDelete::Register(biasingOperator);
+  }
+
+  // The local field manager applies to the envelope and all its daughters.
+  // Logical-volume field managers are thread-local, so this runs per thread.
+  fFieldVolume->SetFieldManager(fElectricFieldSetup.Get()->GetFieldManager(), true);
+}
+
+G4int DetectorConstruction::CheckGeometry(G4int resolution)
+{
+  G4cout << "\n----------------------- Geometry check -----------------------" << G4endl;
+
+  // Overlaps of every placement with its mother and its sisters
+  G4int nofOverlapping = 0;
+  for (G4VPhysicalVolume* volume : *G4PhysicalVolumeStore::GetInstance()) {
+    if (volume->CheckOverlaps(resolution, 0., true, 1)) ++nofOverlapping;
+  }
+
+  // Build the navigation voxels once with statistics. Leave the geometry
+  // in the state we found it; the run manager closes it before each run.
+  G4GeometryManager* geometryManager = G4GeometryManager::GetInstance();
+  G4bool wasClosed = geometryManager->IsGeometryClosed();
+  if (wasClosed) geometryManager->OpenGeometry();
+  geometryManager->CloseGeometry(true, true);
+  if (!wasClosed) geometryManager->OpenGeometry();
+
+  G4cout << " " << G4PhysicalVolumeStore::GetInstance()->size() << " placements checked, "
+         << nofOverlapping << " overlapping" << G4endl;
+  G4cout << "--------------------------------------------------------------\n" << G4endl;
+
+  return nofOverlapping;
+}
+
+void DetectorConstruction::CheckGeometryCommand(G4int resolution)
+{
+  if (CheckGeometry(resolution) > 0) {
+    G4Exception("DetectorConstruction::CheckGeometryCommand", "Tungsten0001",
+                FatalException, "Overlapping volumes in the geometry");
+  }
+}
+
+void DetectorConstruction::UpdateGeometry()
+{
+  // Envelope spanning the field region, and the offset of its daughters
+  G4double envelope_z = 0.5*(fField.zMax + fField.zMin);
+  G4ThreeVector envelope_offset(0, 0, envelope_z);
+  fEnvelopeSolid->SetZHalfLength(0.5*(fField.zMax - fField.zMin));
+  fEnvelopePlacement->SetTranslation(envelope_offset);
+
+  fTungstenSolid->SetXHalfLength(0.5*fTungstenWidth);
+  fTungstenSolid->SetYHalfLength(0.5*fTungstenWidth);
+  fTungstenSolid->SetZHalfLength(0.5*fTungstenLength);
+  fTungstenPlacement->SetTranslation(G4ThreeVector(0, 0, fTungstenZ) - envelope_offset);
+
+  // Detectors at their distance from the exit face of the tungsten
+  G4double exit_face = fTungstenZ + 0.5*fTungstenLength;
+  fDetector1Position = G4ThreeVector(0, 0, exit_face + fDetector1Distance);
+  fDetector2Position = G4ThreeVector(0, 0, exit_face + fDetector2Distance);
+
+  for (G4Tubs* solid : { fDetector1Solid, fDetector2Solid }) {
+    solid->SetOuterRadius(fDetectorRadius);
+    solid->SetZHalfLength(0.5*fDetectorThickness);
+  }
+  fDetector1Placement->SetTranslation(fDetector1Position - envelope_offset);
+  fDetector2Placement->SetTranslation(fDetector2Position - envelope_offset);
+
+  TUNGSTEN_LOG(Logger::kRun, "Tungsten: " << fTungstenWidth/cm << " x " << fTungstenWidth/cm
+               << " x " << fTungstenLength/cm << " cm at z = " << fTungstenZ/cm << " cm");
+  TUNGSTEN_LOG(Logger::kRun, "Detector 1 position: " << fDetector1Position/cm << " cm");
+  TUNGSTEN_LOG(Logger::kRun, "Detector 2 position: " << fDetector2Position/cm << " cm");
+  TUNGSTEN_LOG(Logger::kRun, "Detector radius: " << fDetectorRadius/cm << " cm");
+
+  if (fCheckOverlaps) {
+    for (G4VPhysicalVolume* volume : { fEnvelopePlacement, fTungstenPlacement,
+                                       fDetector1Placement, fDetector2Placement }) {
+      volume->CheckOverlaps();
+    }
+  }
+}
+
+void DetectorConstruction::GeometryChanged()
+{
+  // Before /run/initialize Construct() picks the new values up
+  if (!fEnvelopePlacement) return;
+
+  // Resize and move the existing volumes instead of rebuilding them. The
+  // run manager then only re-optimises the navigation voxels at the next
+  // beamOn; materials, couples and physics tables are kept. Broadcast via
+  // /run/geometryModified, so the worker navigators are reset as well.
+  UpdateGeometry();
+  G4RunManager::GetRunManager()->GeometryHasBeenModified();
+}
+
+G4String DetectorConstruction::FindEnvelopeProblem() const
+{
+  // The daughters must stay inside the solenoid envelope: radius
+  // fFieldRadius, from the field zMin to zMax
+  std::ostringstream problem;
+  const G4double exitFace = fTungstenZ + 0.5*fTungstenLength;
+  const G4double tungstenCorner = std::sqrt(2.)*0.5*fTungstenWidth;
+  const G4double lastDetector = std::max(fDetector1Distance, fDetector2Distance);
+
+  if (fField.zMin >= fField.zMax) {
+    problem << "field zMin " << fField.zMin/m << " m is not below zMax " << fField.zMax/m << " m";
+  } else if (tungstenCorner > fFieldRadius) {
+    problem << "the tungsten block is wider than the " << fFieldRadius/m << " m envelope radius";
+  } else if (fTungstenZ - 0.5*fTungstenLength < fField.zMin) {
+    problem << "the tungsten block starts upstream of the field zMin " << fField.zMin/m << " m";
+  } else if (exitFace + lastDetector + 0.5*fDetectorThickness > fField.zMax) {
+    problem << "a detector ends at z = " << (exitFace + lastDetector + 0.5*fDetectorThickness)/m
+            << " m, downstream of the field zMax " << fField.zMax/m << " m";
+  } else if (fDetectorRadius > fFieldRadius) {
+    problem << "the detector radius exceeds the " << fFieldRadius/m << " m envelope radius";
   }
-}
\ No newline at end of file
+  return problem.str();
+}
+
+G4bool DetectorConstruction::SetDimension(G4double& parameter, G4double value,
+                                          const G4String& name)
+{
+  const G4double previous = parameter;
+  parameter = value;
+  const G4String problem = FindEnvelopeProblem();
+  if (problem.empty()) return true;
+
+  parameter = previous;
+  G4ExceptionDescription description;
+  description << name << " " << G4BestUnit(value, "Length") << " rejected: " << problem;
+  G4Exception("DetectorConstruction::SetDimension", "Tungsten0007", JustWarning, description);
+  return false;
+}
+
+void DetectorConstruction::SetTungstenWidth(G4double value)
+{
+  if (SetDimension(fTungstenWidth, value, "tungstenWidth")) GeometryChanged();
+}
+
+void DetectorConstruction::SetTungstenLength(G4double value)
+{
+  if (SetDimension(fTungstenLength, value, "tungstenLength")) GeometryChanged();
+}
+
+void DetectorConstruction::SetDetector1Distance(G4double value)
+{
+  if (SetDimension(fDetector1Distance, value, "detector1Distance")) GeometryChanged();
+}
+
+void DetectorConstruction::SetDetector2Distance(G4double value)
+{
+  if (SetDimension(fDetector2Distance, value, "detector2Distance")) GeometryChanged();
+}
+
+void DetectorConstruction::SetDetectorRadius(G4double value)
+{
+  if (SetDimension(fDetectorRadius, value, "detectorRadius")) GeometryChanged();
+}
+
+void DetectorConstruction::SetFieldValue(G4double value)
+{
+  // Read directly by the field objects of all threads
+  fField.bz = value;
+  TUNGSTEN_LOG(Logger::kRun, "Solenoid field set to " << value/tesla << " T");
+}
+
+void DetectorConstruction::SetFieldZMin(G4double value)
+{
+  if (SetDimension(fField.zMin, value, "field zMin")) GeometryChanged();
+}
+
+void DetectorConstruction::SetFieldZMax(G4double value)
+{
+  if (SetDimension(fField.zMax, value, "field zMax")) GeometryChanged();
+}
+
+void DetectorConstruction::DefineCommands()
+{
+  // Geometry commands act on the master only
+  fMessenger = new G4GenericMessenger(this, "/tungsten/geom/", "Geometry control");
+
+  fMessenger->DeclareMethod("check", &DetectorConstruction::CheckGeometryCommand,
+                            "Check all placements for overlaps (abort if any) "
+                            "and print the voxelization statistics")
+    .SetParameterName("resolution", true)
+    .SetDefaultValue("10000")
+    .SetStates(G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareProperty("checkOverlaps", fCheckOverlaps,
+                              "Check overlaps of each placement when it is built or moved")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  // Dimensions and positions; changed in place between runs
+  fMessenger->DeclareMethodWithUnit("tungstenWidth", "cm",
+                                    &DetectorConstruction::SetTungstenWidth,
+                                    "Transverse size (x and y) of the tungsten block")
+    .SetParameterName("width", false)
+    .SetRange("width > 0.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethodWithUnit("tungstenLength", "cm",
+                                    &DetectorConstruction::SetTungstenLength,
+                                    "Length (z) of the tungsten block; the detectors "
+                                    "keep their distance from its exit face")
+    .SetParameterName("length", false)
+    .SetRange("length > 0.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethodWithUnit("detector1Distance", "cm",
+                                    &DetectorConstruction::SetDetector1Distance,
+                                    "Distance of detector 1 from the tungsten exit face")
+    .SetParameterName("distance", false)
+    .SetRange("distance > 0.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethodWithUnit("detector2Distance", "cm",
+                                    &DetectorConstruction::SetDetector2Distance,
+                                    "Distance of detector 2 from the tungsten exit face")
+    .SetParameterName("distance", false)
+    .SetRange("distance > 0.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethodWithUnit("detectorRadius", "cm",
+                                    &DetectorConstruction::SetDetectorRadius,
+                                    "Radius of both detector discs")
+    .SetParameterName("radius", false)
+    .SetRange("radius > 0.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  // Solenoid value and extent, shared by all threads. The per-thread
+  // integration settings live in /tungsten/field/ (ElectricFieldSetup).
+  fFieldMessenger = new G4GenericMessenger(this, "/tungsten/field/region/",
+                                           "Solenoid field value and extent");
+
+  fFieldMessenger->DeclareMethodWithUnit("value", "tesla", &DetectorConstruction::SetFieldValue,
+                                         "Solenoid field along +z")
+    .SetParameterName("bz", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fFieldMessenger->DeclareMethodWithUnit("zMin", "m", &DetectorConstruction::SetFieldZMin,
+                                         "Upstream end of the solenoid field (and envelope)")
+    .SetParameterName("zMin", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fFieldMessenger->DeclareMethodWithUnit("zMax", "m", &DetectorConstruction::SetFieldZMax,
+                                         "Downstream end of the solenoid field (and envelope)")
+    .SetParameterName("zMax", false)
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
@@ -0,0 +1,72 @@
+#include "DetectorSD.hh"
+#include "ParticleClassifier.hh"
+#include "PionDecayTrackInfo.hh"
+#include "HitArena.hh"
+#include "Logger.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4EventManager.hh"
+#include "G4Event.hh"
+#include "G4VProcess.hh"
+#include "G4SystemOfUnits.hh"
+
+DetectorSD::DetectorSD(const G4String& name, G4int detectorID)
+: G4VSensitiveDetector(name),
+  fDetectorID(detectorID),
+  fEventID(-1),
+  fClassifier(ParticleClassifier::Instance()),
+  fArena(HitArena::Instance())
+{}
+
+void DetectorSD::Initialize(G4HCofThisEvent*)
+{
+  fEventID = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
+}
+
+G4bool DetectorSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  // Score each particle once, where it enters the disc
+  if (!step->IsFirstStepInVolume()) return false;
+
+  const G4Track* track = step->GetTrack();
+  const ParticleClassifier::Species species = fClassifier->Classify(track->GetDefinition());
+  if (!ParticleClassifier::IsMuon(species) && !ParticleClassifier::IsChargedPion(species)) {
+    return false;
+  }
+
+  const G4ThreeVector& position = step->GetPreStepPoint()->GetPosition();
+  const G4ThreeVector& direction = track->GetMomentumDirection();
+
+  HitRecord record;
+  record.eventID = fEventID;
+  record.species = species;
+  record.detectorID = fDetectorID;
+  record.kineticEnergy = track->GetKineticEnergy()/MeV;
+  record.weight = track->GetWeight();
+  const G4VProcess* creator = track->GetCreatorProcess();
+  record.creatorProcess = creator ? creator->GetProcessSubType() : -1;
+  for (G4int k = 0; k < 3; ++k) {
+    record.position[k] = position[k]/mm;
+    record.direction[k] = direction[k];
+  }
+
+  // Muons from a charged-pion decay carry their origin (TrackingAction)
+  auto* decayInfo = static_cast<const PionDecayTrackInfo*>(track->GetUserInformation());
+  if (decayInfo) {
+    record.parentSpecies = static_cast<std::uint8_t>(decayInfo->GetParentSpecies());
+    record.decayZ = decayInfo->GetDecayZ()/mm;
+  } else {
+    record.parentSpecies = ParticleClassifier::kOther;
+    record.decayZ = 0.f;
+  }
+  fArena->Add(record);
+
+  TUNGSTEN_LOG(Logger::kStep, "\n!!! "
+               << (ParticleClassifier::IsMuon(species) ? "MUON" : "PION")
+               << " DETECTED IN DETECTOR " << fDetectorID << " !!!"
+               << "\nType: " << ParticleClassifier::GetHitLabel(fDetectorID, species)
+               << "\nEnergy: " << track->GetKineticEnergy()/MeV << " MeV"
+               << "\nPosition: " << position/CLHEP::m << " m");
+  return true;
+}
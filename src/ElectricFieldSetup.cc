@@ -1,92 +1,201 @@
 // Include necessary headers for magnetic field
 #include "ElectricFieldSetup.hh"
-#include "G4UniformMagField.hh"
-#include "G4MagneticField.hh"
+#include "LimitedRegionField.hh"
+#include "Logger.hh"
 #include "G4FieldManager.hh"
-#include "G4TransportationManager.hh"
 #include "G4MagIntegratorDriver.hh"
+#include "G4InterpolationDriver.hh"
 #include "G4ChordFinder.hh"
 #include "G4ClassicalRK4.hh"
-#include "G4MagneticField.hh"
+#include "G4DormandPrince745.hh"
+#include "G4ExactHelixStepper.hh"
 #include "G4Mag_UsualEqRhs.hh"
+#include "G4GenericMessenger.hh"
 #include "G4SystemOfUnits.hh"  // This will include the units
 
-// Define a custom limited-region magnetic field class
-class LimitedRegionField : public G4MagneticField {
-public:
-    LimitedRegionField(G4double zMax, G4double zMin) : fZMax(zMax), fZMin(zMin) {}
-    
-    virtual void GetFieldValue(const G4double point[4], G4double* field) const override
-    {
-        // Initialize field to zero
-        field[0] = 0.0;
-        field[1] = 0.0;
-        field[2] = 0.0;
-        field[3] = 0.0;
-        field[4] = 0.0;
-        field[5] = 0.0;
-        
-        // Check if the point is within our defined region (zMin to zMax)
-        if (point[2] <= fZMax && point[2] >= fZMin) {
-            field[2] = 7.0 * CLHEP::tesla; // 7 Tesla in +z direction
-        }
-    }
-    
-private:
-    G4double fZMax; // Upper Z limit of the field
-    G4double fZMin; // Lower Z limit of the field
-};
-
 // Constructor for ElectricFieldSetup
-ElectricFieldSetup::ElectricFieldSetup() {
-    // Create a limited region field that extends from z=-5 to z=5
-    G4double zMax = 10.0 * CLHEP::m;  // Upper limit (5 meters)
-    G4double zMin = -5.0 * CLHEP::m; // Lower limit (-5 meters)
-    fMagneticField = new LimitedRegionField(zMax, zMin);
+ElectricFieldSetup::ElectricFieldSetup(const FieldParameters& parameters)
+: fChordFinder(nullptr),
+  fStepper(nullptr),
+  fMessenger(nullptr),
+  fStepperType("DormandPrince745"),
+  fDriverType("Interpolation"),
+  fMinStep(0.01*mm),
+  fDeltaChord(0.25*mm)
+{
+    // Create a limited region field between zMin and zMax
+    fMagneticField = new LimitedRegionField(parameters);
     
-    // Get the global field manager
-    fFieldManager = G4TransportationManager::GetTransportationManager()->GetFieldManager();
+    // Local field manager, attached to the solenoid envelope by
+    // DetectorConstruction; the global one stays field-free
+    fFieldManager = new G4FieldManager();
     
     // Create equation of motion for this field
-    G4Mag_UsualEqRhs* equation = new G4Mag_UsualEqRhs(fMagneticField);
-    
-    // Create stepper with higher precision
-    fStepper = new G4ClassicalRK4(equation);
+    fEquation = new G4Mag_UsualEqRhs(fMagneticField);
     
-    // Create the chord finder with a smaller min step for better precision at boundary
-    G4double minStep = 0.005 * CLHEP::mm; // Smaller minimum step for better precision
-    G4MagInt_Driver* driver = new G4MagInt_Driver(minStep,
-                                                 fStepper,
-                                                 fStepper->GetNumberOfVariables());
-    fChordFinder = new G4ChordFinder(driver);
+    // Stepper, driver and chord finder
+    UpdateChordFinder();
     
-    // Increase accuracy requirements for better tracking at field boundary
-    fFieldManager->SetDeltaOneStep(0.001 * CLHEP::mm);  // Precision in one step
+    // Accuracy: Geant4's defaults are ample for muon/pion momenta; the
+    // /tungsten/field/ commands tighten them when needed
+    fFieldManager->SetDeltaOneStep(0.01 * CLHEP::mm);  // Precision in one step
     fFieldManager->SetDeltaIntersection(0.001 * CLHEP::mm);  // Precision in intersection
     
     // Set the field manager's parameters
-    fFieldManager->SetChordFinder(fChordFinder);
     fFieldManager->SetDetectorField(fMagneticField);
+
+    DefineCommands();
     
-    G4cout << "Magnetic field of 7 Tesla in +z direction created, limited to region from "
-           << zMin/CLHEP::m << " to " << zMax/CLHEP::m << " meters along z-axis" << G4endl;
-    G4cout << "Particles will maintain their direction after leaving the field region" << G4endl;
+    TUNGSTEN_LOG(Logger::kRun, "Magnetic field of " << parameters.bz/CLHEP::tesla
+                 << " Tesla in +z direction created, limited to region from "
+                 << parameters.zMin/CLHEP::m << " to " << parameters.zMax/CLHEP::m
+                 << " meters along z-axis");
 }
 
 // Destructor for ElectricFieldSetup
 ElectricFieldSetup::~ElectricFieldSetup() {
+    delete fMessenger;
+    delete fFieldManager;
     delete fChordFinder;
     delete fStepper;
+    delete fEquation;
     delete fMagneticField;
 }
 
-// Method to update the magnetic field
-void ElectricFieldSetup::SetMagneticField(G4ThreeVector fieldVector) {
-    // This method is kept for potential future field value changes
-    // It's not needed for the current implementation
-    
-    G4cout << "Magnetic field set to ("
-          << fieldVector.x()/CLHEP::tesla << " "
-          << fieldVector.y()/CLHEP::tesla << " "
-          << fieldVector.z()/CLHEP::tesla << ") Tesla" << G4endl;
-}
\ No newline at end of file
+void ElectricFieldSetup::SetStepperType(const G4String& name)
+{
+    fStepperType = name;
+    UpdateChordFinder();
+}
+
+void ElectricFieldSetup::SetDriverType(const G4String& name)
+{
+    fDriverType = name;
+    UpdateChordFinder();
+}
+
+void ElectricFieldSetup::SetMinStep(G4double value)
+{
+    fMinStep = value;
+    UpdateChordFinder();
+}
+
+void ElectricFieldSetup::SetDeltaChord(G4double value)
+{
+    fDeltaChord = value;
+    fChordFinder->SetDeltaChord(fDeltaChord);
+}
+
+void ElectricFieldSetup::SetDeltaOneStep(G4double value)
+{
+    fFieldManager->SetDeltaOneStep(value);
+}
+
+void ElectricFieldSetup::SetDeltaIntersection(G4double value)
+{
+    fFieldManager->SetDeltaIntersection(value);
+}
+
+void ElectricFieldSetup::SetMinEpsilonStep(G4double value)
+{
+    fFieldManager->SetMinimumEpsilonStep(value);
+}
+
+void ElectricFieldSetup::SetMaxEpsilonStep(G4double value)
+{
+    fFieldManager->SetMaximumEpsilonStep(value);
+}
+
+G4long ElectricFieldSetup::GetNumberOfFieldCalls() const
+{
+    return fMagneticField->GetNumberOfCalls();
+}
+
+void ElectricFieldSetup::ResetNumberOfFieldCalls()
+{
+    fMagneticField->ResetNumberOfCalls();
+}
+
+void ElectricFieldSetup::UpdateChordFinder()
+{
+    // The chord finder owns the driver, not the stepper
+    delete fChordFinder;
+    fChordFinder = nullptr;
+    delete fStepper;
+    fStepper = nullptr;
+
+    G4VIntegrationDriver* driver = nullptr;
+    if (fStepperType == "DormandPrince745") {
+        auto* stepper = new G4DormandPrince745(fEquation);
+        fStepper = stepper;
+        if (fDriverType == "Interpolation") {
+            driver = new G4InterpolationDriver<G4DormandPrince745>(
+                fMinStep, stepper, stepper->GetNumberOfVariables());
+        }
+    }
+    else if (fStepperType == "ExactHelix") {
+        // Exact for a uniform field, i.e. everywhere inside the solenoid
+        fStepper = new G4ExactHelixStepper(fEquation);
+    }
+    else {
+        fStepper = new G4ClassicalRK4(fEquation);
+    }
+
+    if (!driver) {
+        if (fDriverType == "Interpolation") {
+            G4cerr << "WARNING: the Interpolation driver needs the DormandPrince745 stepper;"
+                   << " using MagInt with " << fStepperType << G4endl;
+        }
+        driver = new G4MagInt_Driver(fMinStep, fStepper, fStepper->GetNumberOfVariables());
+    }
+
+    fChordFinder = new G4ChordFinder(driver);
+    fChordFinder->SetDeltaChord(fDeltaChord);
+    fFieldManager->SetChordFinder(fChordFinder);
+
+    TUNGSTEN_LOG(Logger::kRun, "Field integration: " << fStepperType << " stepper, "
+                 << fDriverType << " driver, min step " << fMinStep/mm << " mm");
+}
+
+void ElectricFieldSetup::DefineCommands()
+{
+    // One messenger per thread; the commands are broadcast to the workers
+    fMessenger = new G4GenericMessenger(this, "/tungsten/field/",
+                                        "Magnetic field integration");
+
+    fMessenger->DeclareMethod("stepper", &ElectricFieldSetup::SetStepperType,
+                              "Integration stepper")
+      .SetCandidates("ClassicalRK4 DormandPrince745 ExactHelix")
+      .SetStates(G4State_PreInit, G4State_Idle);
+
+    fMessenger->DeclareMethod("driver", &ElectricFieldSetup::SetDriverType,
+                              "Integration driver (Interpolation needs DormandPrince745)")
+      .SetCandidates("MagInt Interpolation")
+      .SetStates(G4State_PreInit, G4State_Idle);
+
+    fMessenger->DeclareMethodWithUnit("minStep", "mm", &ElectricFieldSetup::SetMinStep,
+                                      "Minimum step of the integration driver")
+      .SetStates(G4State_PreInit, G4State_Idle);
+
+    fMessenger->DeclareMethodWithUnit("deltaChord", "mm", &ElectricFieldSetup::SetDeltaChord,
+                                      "Maximum miss distance of a chord")
+      .SetStates(G4State_PreInit, G4State_Idle);
+
+    fMessenger->DeclareMethodWithUnit("deltaOneStep", "mm",
+                                      &ElectricFieldSetup::SetDeltaOneStep,
+                                      "Position accuracy of one step")
+      .SetStates(G4State_PreInit, G4State_Idle);
+
+    fMessenger->DeclareMethodWithUnit("deltaIntersection", "mm",
+                                      &ElectricFieldSetup::SetDeltaIntersection,
+                                      "Accuracy of boundary intersections")
+      .SetStates(G4State_PreInit, G4State_Idle);
+
+    fMessenger->DeclareMethod("minEpsilonStep", &ElectricFieldSetup::SetMinEpsilonStep,
+                              "Minimum relative accuracy of a step")
+      .SetStates(G4State_PreInit, G4State_Idle);
+
+    fMessenger->DeclareMethod("maxEpsilonStep", &ElectricFieldSetup::SetMaxEpsilonStep,
+                              "Maximum relative accuracy of a step")
+      .SetStates(G4State_PreInit, G4State_Idle);
+}
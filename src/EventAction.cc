@@ -1,18 +1,27 @@
 #include "EventAction.hh"
 #include "RunAction.hh"
+#include "Logger.hh"
+#include "HitArena.hh"
+#include "TungstenHit.hh"
+#include "PhaseSpaceHit.hh"
+#include "PhaseSpace.hh"
+#include "Histograms.hh"
+#include "Telemetry.hh"
 #include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4SDManager.hh"
 #include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
 
-EventAction::EventAction()
+EventAction::EventAction(RunAction* runAction)
 : G4UserEventAction(),
+  fRunAction(runAction),
+  fEventID(-1),
   fEdep(0.),
-  fMuonsAtDetector1(0),
-  fPionsAtDetector1(0),
-  fMuonsAtDetector2(0),
-  fPionsAtDetector2(0)
+  fTungstenHCID(-1),
+  fTungstenExitsHCID(-1)
 {
-  // Constructor implementation (if needed)
+  fTally.Reset();
 }
 
 EventAction::~EventAction()
@@ -20,28 +29,97 @@ EventAction::~EventAction()
   // Destructor implementation (if needed)
 }
 
-void EventAction::BeginOfEventAction(const G4Event*)
+void EventAction::BeginOfEventAction(const G4Event* event)
 {
   // Reset all accumulated values at the beginning of each event
+  fEventID = event->GetEventID();
   fEdep = 0.;
-  fMuonsAtDetector1 = 0;
-  fPionsAtDetector1 = 0;
-  fMuonsAtDetector2 = 0;
-  fPionsAtDetector2 = 0;
+  fTally.Reset();
+  HitArena::Instance()->Reset();
+  Telemetry::BeginOfEvent();
 }
 
 void EventAction::EndOfEventAction(const G4Event* event)
 {
+  ProcessDetectorHits();
+
+  G4HCofThisEvent* hce = event->GetHCofThisEvent();
+  if (hce) {
+    if (fTungstenHCID < 0) {
+      G4SDManager* sdManager = G4SDManager::GetSDMpointer();
+      fTungstenHCID = sdManager->GetCollectionID("TungstenSD/TungstenHits");
+      fTungstenExitsHCID = sdManager->GetCollectionID("TungstenSD/TungstenExits");
+    }
+
+    if (fTungstenHCID >= 0) {
+      auto* tungstenHits = static_cast<TungstenHitsCollection*>(hce->GetHC(fTungstenHCID));
+      if (tungstenHits && tungstenHits->entries() > 0) {
+        fEdep = (*tungstenHits)[0]->GetEdep();
+      }
+    }
+
+    if (PhaseSpace::IsRecording()) ProcessTungstenExits(hce);
+  }
+
+  Histograms::FillTungstenEdep(fEdep);
+  fRunAction->AddEvent(fTally);
+  Telemetry::EndOfEvent();
+
   // Print event information
-  G4int eventID = event->GetEventID();
-  G4cout << "\n--------------------" << G4endl;
-  G4cout << "Event " << eventID << " completed." << G4endl;
-  G4cout << "Energy deposit: " << fEdep/MeV << " MeV" << G4endl;
-  
-  // Print detector counts
-  G4cout << "Detector 1 - Muons: " << fMuonsAtDetector1 
-         << ", Pions: " << fPionsAtDetector1 << G4endl;
-  G4cout << "Detector 2 (10m) - Muons: " << fMuonsAtDetector2 
-         << ", Pions: " << fPionsAtDetector2 << G4endl;
-  G4cout << "--------------------" << G4endl;
-}
\ No newline at end of file
+  TUNGSTEN_LOG(Logger::kEvent, "\n--------------------"
+               << "\nEvent " << event->GetEventID() << " completed."
+               << "\nEnergy deposit: " << fEdep/MeV << " MeV"
+               << "\nDetector 1 - Muons: " << GetMuons(RunStatistics::kDetector1)
+               << ", Pions: " << GetPions(RunStatistics::kDetector1)
+               << "\nDetector 2 (10m) - Muons: " << GetMuons(RunStatistics::kDetector2)
+               << ", Pions: " << GetPions(RunStatistics::kDetector2)
+               << "\n--------------------");
+}
+
+void EventAction::ProcessDetectorHits()
+{
+  HitArena* arena = HitArena::Instance();
+#ifdef TUNGSTEN_COUNT_ALLOCATIONS
+  AllocationCounter::Scope scope(arena->GetAllocationSink());
+#endif
+
+  for (const HitRecord& record : *arena) {
+    const RunStatistics::Location location
+      = record.detectorID == 2 ? RunStatistics::kDetector2 : RunStatistics::kDetector1;
+    fTally.Add(location, static_cast<ParticleClassifier::Species>(record.species),
+               record.weight, record.kineticEnergy);
+    Histograms::FillHit(record);
+  }
+  fRunAction->RecordHits(arena->GetRecords(), arena->GetSize());
+}
+
+void EventAction::ProcessTungstenExits(G4HCofThisEvent* hce)
+{
+  if (fTungstenExitsHCID < 0) return;
+  auto* exits = static_cast<PhaseSpaceHitsCollection*>(hce->GetHC(fTungstenExitsHCID));
+  if (!exits) return;
+
+  for (std::size_t i = 0; i < exits->entries(); ++i) {
+    fRunAction->RecordPhaseSpace((*exits)[i]->GetRecord());
+  }
+
+  // An empty event still takes one record (pdg 0), so that stage 2 replays
+  // as many events as stage 1 ran and the per-proton yields stay comparable
+  if (exits->entries() == 0) {
+    PhaseSpaceRecord placeholder{};
+    placeholder.eventID = fEventID;
+    fRunAction->RecordPhaseSpace(placeholder);
+  }
+}
+
+G4double EventAction::GetMuons(RunStatistics::Location location) const
+{
+  return fTally.counts[location][ParticleClassifier::kMuonPlus]
+         + fTally.counts[location][ParticleClassifier::kMuonMinus];
+}
+
+G4double EventAction::GetPions(RunStatistics::Location location) const
+{
+  return fTally.counts[location][ParticleClassifier::kPionPlus]
+         + fTally.counts[location][ParticleClassifier::kPionMinus];
+}
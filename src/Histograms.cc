@@ -0,0 +1,102 @@
+#include "Histograms.hh"
+#include "HitRecord.hh"
+
+#include "G4AnalysisManager.hh"
+#include "G4GenericMessenger.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+
+G4bool Histograms::fgEnabled = true;
+G4String Histograms::fgOutputPrefix = "histograms";
+G4String Histograms::fgFileType = "root";
+
+void Histograms::Book()
+{
+  auto* analysisManager = G4AnalysisManager::Instance();
+  analysisManager->SetVerboseLevel(0);
+
+  // Booked in ID order: the Get*ID() functions rely on it
+  for (G4int detectorID = 1; detectorID <= 2; ++detectorID) {
+    for (G4int i = 0; i < kNumberOfHitSpecies; ++i) {
+      const G4String& name = ParticleClassifier::GetName(static_cast<ParticleClassifier::Species>(i));
+      analysisManager->CreateH1("d" + std::to_string(detectorID) + "_energy_" + name,
+                                name + " kinetic energy at detector "
+                                + std::to_string(detectorID),
+                                160, 0., 8.*GeV, "GeV");
+    }
+  }
+  for (G4int detectorID = 1; detectorID <= 2; ++detectorID) {
+    analysisManager->CreateH1("d" + std::to_string(detectorID) + "_radius",
+                              "Hit radius at detector " + std::to_string(detectorID),
+                              100, 0., 100.*cm, "cm");
+  }
+  analysisManager->CreateH1("pion_decay_z", "z of the pi+- decay vertices",
+                            150, -5.*m, 10.*m, "m");
+  analysisManager->CreateH1("tungsten_edep", "Energy deposit in the tungsten per event",
+                            160, 0., 8.*GeV, "GeV");
+}
+
+void Histograms::OpenFile(G4int runID)
+{
+  // The extension selects the output format
+  if (!fgEnabled) return;
+  G4AnalysisManager::Instance()->OpenFile(fgOutputPrefix + std::to_string(runID)
+                                          + "." + fgFileType);
+}
+
+void Histograms::WriteFile()
+{
+  if (!fgEnabled) return;
+  auto* analysisManager = G4AnalysisManager::Instance();
+  if (!analysisManager->IsOpenFile()) return;
+  // Workers merge into the master here; closing resets for the next run
+  analysisManager->Write();
+  analysisManager->CloseFile();
+}
+
+void Histograms::FillHit(const HitRecord& hit)
+{
+  if (!fgEnabled) return;
+  auto* analysisManager = G4AnalysisManager::Instance();
+  const auto species = static_cast<ParticleClassifier::Species>(hit.species);
+  if (species < kNumberOfHitSpecies) {
+    analysisManager->FillH1(GetEnergyID(hit.detectorID, species),
+                            hit.kineticEnergy*MeV, hit.weight);
+  }
+  const G4double radius = std::hypot(hit.position[0], hit.position[1])*mm;
+  analysisManager->FillH1(GetRadiusID(hit.detectorID), radius, hit.weight);
+}
+
+void Histograms::FillPionDecay(G4double z, G4double weight)
+{
+  if (fgEnabled) G4AnalysisManager::Instance()->FillH1(kPionDecayZ, z, weight);
+}
+
+void Histograms::FillTungstenEdep(G4double edep)
+{
+  if (fgEnabled) G4AnalysisManager::Instance()->FillH1(kTungstenEdep, edep);
+}
+
+G4GenericMessenger* Histograms::CreateMessenger()
+{
+  auto* messenger = new G4GenericMessenger(nullptr, "/tungsten/histo/",
+                                           "Run histograms (binning: /analysis/h1/set)");
+
+  // Read by every thread at the start of a run, so the commands stay on the master
+  messenger->DeclareProperty("enable", fgEnabled, "Fill and write the histograms")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclareProperty("output", fgOutputPrefix,
+                             "Histogram files are named <prefix><runID>.<type>")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclareProperty("type", fgFileType, "Histogram file type")
+    .SetCandidates("root csv xml")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  return messenger;
+}
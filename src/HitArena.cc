@@ -0,0 +1,50 @@
+#include "HitArena.hh"
+
+#include <algorithm>
+
+namespace
+{
+  const std::size_t kInitialCapacity = 64;
+}
+
+HitArena* HitArena::Instance()
+{
+  static G4ThreadLocal HitArena* instance = nullptr;
+  if (!instance) instance = new HitArena();
+  return instance;
+}
+
+HitArena::HitArena()
+: fMaxSize(0),
+  fGrowths(0),
+  fEvents(0),
+  fAllocations(0),
+  fWarmUpAllocations(0)
+{
+  fRecords.reserve(kInitialCapacity);
+}
+
+void HitArena::BeginOfRun()
+{
+  fMaxSize = 0;
+  fGrowths = 0;
+  fAllocations = 0;
+}
+
+void HitArena::Reset()
+{
+  fMaxSize = std::max(fMaxSize, fRecords.size());
+  fRecords.clear();  // keeps the capacity
+  ++fEvents;
+}
+
+void HitArena::PrintReport() const
+{
+  G4cout << "Hit arena: up to " << std::max(fMaxSize, fRecords.size())
+         << " hits per event, capacity " << fRecords.capacity()
+         << ", grown " << fGrowths << " times in this run";
+#ifdef TUNGSTEN_COUNT_ALLOCATIONS
+  G4cout << ", " << fAllocations << " allocations in the hit path after the first event";
+#endif
+  G4cout << G4endl;
+}
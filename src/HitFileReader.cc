@@ -0,0 +1,71 @@
+#include "HitFileReader.hh"
+
+#include <cstring>
+
+namespace
+{
+  template <typename T>
+  T Extract(const char*& cursor)
+  {
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+  }
+
+  // Bytes per record summed over all columns
+  const std::size_t kRecordBytes = sizeof(std::int32_t) + 3*sizeof(std::uint8_t)
+                                   + 9*sizeof(G4float) + sizeof(std::int16_t);
+}
+
+G4bool HitFileReader::Open(const G4String& fileName)
+{
+  fFile.open(fileName, std::ios::binary);
+  if (!fFile.is_open()) return false;
+
+  char magic[sizeof(HitFileFormat::kMagic)];
+  std::uint32_t version = 0;
+  fFile.read(magic, sizeof(magic));
+  fFile.read(reinterpret_cast<char*>(&version), sizeof(version));
+
+  if (!fFile || std::memcmp(magic, HitFileFormat::kMagic, sizeof(magic)) != 0
+      || version != HitFileFormat::kVersion) {
+    G4cerr << "ERROR: " << fileName << " is not a version "
+           << HitFileFormat::kVersion << " hit file" << G4endl;
+    fFile.close();
+    return false;
+  }
+  return true;
+}
+
+G4bool HitFileReader::ReadBlock(std::vector<HitRecord>& records)
+{
+  records.clear();
+
+  std::uint32_t n = 0;
+  if (!fFile.read(reinterpret_cast<char*>(&n), sizeof(n))) return false;
+
+  fColumns.resize(n*kRecordBytes);
+  if (!fFile.read(fColumns.data(), fColumns.size())) {
+    G4cerr << "ERROR: truncated block in hit file" << G4endl;
+    return false;
+  }
+
+  records.resize(n);
+  const char* cursor = fColumns.data();
+  for (auto& r : records) r.eventID = Extract<std::int32_t>(cursor);
+  for (auto& r : records) r.species = Extract<std::uint8_t>(cursor);
+  for (auto& r : records) r.detectorID = Extract<std::uint8_t>(cursor);
+  for (auto& r : records) r.kineticEnergy = Extract<G4float>(cursor);
+  for (G4int k = 0; k < 3; ++k) {
+    for (auto& r : records) r.position[k] = Extract<G4float>(cursor);
+  }
+  for (G4int k = 0; k < 3; ++k) {
+    for (auto& r : records) r.direction[k] = Extract<G4float>(cursor);
+  }
+  for (auto& r : records) r.weight = Extract<G4float>(cursor);
+  for (auto& r : records) r.parentSpecies = Extract<std::uint8_t>(cursor);
+  for (auto& r : records) r.decayZ = Extract<G4float>(cursor);
+  for (auto& r : records) r.creatorProcess = Extract<std::int16_t>(cursor);
+  return true;
+}
@@ -0,0 +1,184 @@
+#include "HitWriter.hh"
+#include "HitFileReader.hh"
+
+#include <algorithm>
+
+namespace
+{
+  template <typename T>
+  void Append(std::vector<char>& buffer, T value)
+  {
+    const char* bytes = reinterpret_cast<const char*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+}
+
+HitWriter::HitWriter()
+: fFirstFull(0),
+  fNofFull(0),
+  fNofFree(0),
+  fCurrent(nullptr),
+  fDone(false)
+{
+  for (std::size_t i = 0; i < kNofBlocks; ++i) {
+    fBlocks[i].reset(new Block);
+    fFreeBlocks[fNofFree++] = fBlocks[i].get();
+  }
+}
+
+HitWriter::~HitWriter()
+{
+  Close();
+}
+
+G4bool HitWriter::Open(const G4String& fileName)
+{
+  Close();
+
+  fFile.open(fileName, std::ios::binary | std::ios::trunc);
+  if (!fFile.is_open()) return false;
+
+  fFile.write(HitFileFormat::kMagic, sizeof(HitFileFormat::kMagic));
+  fFile.write(reinterpret_cast<const char*>(&HitFileFormat::kVersion),
+              sizeof(HitFileFormat::kVersion));
+
+  fDone = false;
+  fCurrent = fFreeBlocks[--fNofFree];
+  fThread = std::thread(&HitWriter::Run, this);
+  return true;
+}
+
+void HitWriter::Close()
+{
+  if (!fCurrent) return;
+
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    if (fCurrent->size > 0) {
+      fFullBlocks[(fFirstFull + fNofFull++) % kNofBlocks] = fCurrent;
+    } else {
+      fFreeBlocks[fNofFree++] = fCurrent;
+    }
+    fCurrent = nullptr;
+    fDone = true;
+  }
+  fCondition.notify_one();
+  fThread.join();
+  fFile.close();
+}
+
+G4bool HitWriter::MergeFiles(const std::vector<G4String>& inputs,
+                             const G4String& output)
+{
+  // One reader and one decoded block per input
+  struct Shard {
+    HitFileReader reader;
+    std::vector<HitRecord> records;
+    std::size_t next = 0;
+  };
+  std::vector<std::unique_ptr<Shard>> shards;
+  for (const G4String& input : inputs) {
+    std::unique_ptr<Shard> shard(new Shard);
+    if (!shard->reader.Open(input)) return false;
+    if (shard->reader.ReadBlock(shard->records)) shards.push_back(std::move(shard));
+  }
+
+  HitWriter writer;
+  if (!writer.Open(output)) return false;
+
+  // k-way merge; the number of shards is the thread count, so a linear scan
+  // for the smallest event ID is cheaper than a heap
+  while (!shards.empty()) {
+    std::size_t first = 0;
+    for (std::size_t i = 1; i < shards.size(); ++i) {
+      const Shard& a = *shards[i];
+      const Shard& b = *shards[first];
+      if (a.records[a.next].eventID < b.records[b.next].eventID) first = i;
+    }
+
+    Shard& shard = *shards[first];
+    const G4int eventID = shard.records[shard.next].eventID;
+    // Copy the whole event from this shard
+    do {
+      writer.Write(shard.records[shard.next]);
+      if (++shard.next == shard.records.size()) {
+        shard.next = 0;
+        if (!shard.reader.ReadBlock(shard.records)) break;
+      }
+    } while (shard.records[shard.next].eventID == eventID);
+
+    if (shard.records.empty()) shards.erase(shards.begin() + first);
+  }
+
+  writer.Close();
+  return true;
+}
+
+void HitWriter::Write(const HitRecord* records, std::size_t n)
+{
+  while (fCurrent && n > 0) {
+    const std::size_t count = std::min(n, kBlockSize - fCurrent->size);
+    std::copy(records, records + count, fCurrent->records + fCurrent->size);
+    fCurrent->size += count;
+    records += count;
+    n -= count;
+    if (fCurrent->size == kBlockSize) Submit();
+  }
+}
+
+void HitWriter::Submit()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  fFullBlocks[(fFirstFull + fNofFull++) % kNofBlocks] = fCurrent;
+  fCondition.notify_one();
+
+  // Wait for the disk only if all the other blocks are still queued
+  fFreeCondition.wait(lock, [this] { return fNofFree > 0; });
+  fCurrent = fFreeBlocks[--fNofFree];
+}
+
+void HitWriter::Run()
+{
+  std::unique_lock<std::mutex> lock(fMutex);
+  for (;;) {
+    fCondition.wait(lock, [this] { return fDone || fNofFull > 0; });
+    if (fNofFull == 0) return;  // closed and drained
+
+    Block* block = fFullBlocks[fFirstFull];
+    fFirstFull = (fFirstFull + 1) % kNofBlocks;
+    --fNofFull;
+
+    lock.unlock();
+    WriteBlock(*block);
+    block->size = 0;
+    lock.lock();
+
+    fFreeBlocks[fNofFree++] = block;
+    fFreeCondition.notify_one();
+  }
+}
+
+void HitWriter::WriteBlock(const Block& block)
+{
+  const std::size_t n = block.size;
+  const HitRecord* records = block.records;
+
+  fColumns.clear();
+  Append<std::uint32_t>(fColumns, n);
+  for (std::size_t i = 0; i < n; ++i) Append<std::int32_t>(fColumns, records[i].eventID);
+  for (std::size_t i = 0; i < n; ++i) Append<std::uint8_t>(fColumns, records[i].species);
+  for (std::size_t i = 0; i < n; ++i) Append<std::uint8_t>(fColumns, records[i].detectorID);
+  for (std::size_t i = 0; i < n; ++i) Append<G4float>(fColumns, records[i].kineticEnergy);
+  for (G4int k = 0; k < 3; ++k) {
+    for (std::size_t i = 0; i < n; ++i) Append<G4float>(fColumns, records[i].position[k]);
+  }
+  for (G4int k = 0; k < 3; ++k) {
+    for (std::size_t i = 0; i < n; ++i) Append<G4float>(fColumns, records[i].direction[k]);
+  }
+  for (std::size_t i = 0; i < n; ++i) Append<G4float>(fColumns, records[i].weight);
+  for (std::size_t i = 0; i < n; ++i) Append<std::uint8_t>(fColumns, records[i].parentSpecies);
+  for (std::size_t i = 0; i < n; ++i) Append<G4float>(fColumns, records[i].decayZ);
+  for (std::size_t i = 0; i < n; ++i) Append<std::int16_t>(fColumns, records[i].creatorProcess);
+
+  fFile.write(fColumns.data(), fColumns.size());
+}
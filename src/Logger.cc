@@ -0,0 +1,25 @@
+#include "Logger.hh"
+
+#include "G4GenericMessenger.hh"
+
+G4int Logger::fgLevel = Logger::kRun;
+
+G4GenericMessenger* Logger::CreateMessenger()
+{
+  auto* messenger = new G4GenericMessenger(nullptr, "/tungsten/",
+                                           "Tungsten target simulation control");
+
+  // The level is shared by all threads, so the command stays on the master
+  messenger->DeclareProperty("verbose", fgLevel,
+      "0: errors only, 1: run summaries, 2: per-event summary, "
+      "3: every detector hit and pion decay")
+    .SetParameterName("level", false)
+    .SetRange("level >= 0 && level <= 3")
+    .SetToBeBroadcasted(false);
+
+  if (TUNGSTEN_MAX_LOG_LEVEL < Logger::kStep) {
+    G4cout << "Logger: output above level " << TUNGSTEN_MAX_LOG_LEVEL
+           << " is compiled out" << G4endl;
+  }
+  return messenger;
+}
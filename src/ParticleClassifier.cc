@@ -0,0 +1,82 @@
+#include "ParticleClassifier.hh"
+
+#include "G4MuonPlus.hh"
+#include "G4MuonMinus.hh"
+#include "G4PionPlus.hh"
+#include "G4PionMinus.hh"
+#include "G4PionZero.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4VProcess.hh"
+
+#include <algorithm>
+
+namespace
+{
+  const G4String kSpeciesNames[ParticleClassifier::kNumberOfSpecies + 1] = {
+    "mu+", "mu-", "pi+", "pi-", "pi0", "other"
+  };
+
+  // Detector 2 hits carry a "2" prefix, as in the original CSV layout
+  const G4String kHitLabels[2][ParticleClassifier::kNumberOfSpecies + 1] = {
+    { "mu+", "mu-", "pi+", "pi-", "pi0", "other" },
+    { "2mu+", "2mu-", "2pi+", "2pi-", "2pi0", "2other" }
+  };
+
+  const G4VProcess* FindDecayProcess(const G4ParticleDefinition* particle)
+  {
+    const G4ProcessManager* manager = particle->GetProcessManager();
+    if (!manager) return nullptr;
+
+    const G4ProcessVector* processes = manager->GetProcessList();
+    for (std::size_t i = 0; i < processes->size(); ++i) {
+      const G4VProcess* process = (*processes)[i];
+      if (process->GetProcessType() == fDecay) return process;
+    }
+    return nullptr;
+  }
+}
+
+ParticleClassifier* ParticleClassifier::Instance()
+{
+  static G4ThreadLocal ParticleClassifier* instance = nullptr;
+  if (!instance) instance = new ParticleClassifier();
+  return instance;
+}
+
+ParticleClassifier::ParticleClassifier()
+{
+  for (G4int i = 0; i < kNumberOfSpecies; ++i) fDecayProcess[i] = nullptr;
+}
+
+void ParticleClassifier::Build()
+{
+  const G4ParticleDefinition* definitions[kNumberOfSpecies] = {
+    G4MuonPlus::Definition(),
+    G4MuonMinus::Definition(),
+    G4PionPlus::Definition(),
+    G4PionMinus::Definition(),
+    G4PionZero::Definition()
+  };
+
+  G4int maxID = 0;
+  for (const G4ParticleDefinition* definition : definitions) {
+    maxID = std::max(maxID, definition->GetInstanceID());
+  }
+
+  fSpeciesTable.assign(maxID + 1, kOther);
+  for (G4int i = 0; i < kNumberOfSpecies; ++i) {
+    fSpeciesTable[definitions[i]->GetInstanceID()] = static_cast<Species>(i);
+    fDecayProcess[i] = FindDecayProcess(definitions[i]);
+  }
+}
+
+const G4String& ParticleClassifier::GetName(Species species)
+{
+  return kSpeciesNames[species];
+}
+
+const G4String& ParticleClassifier::GetHitLabel(G4int detectorID, Species species)
+{
+  return kHitLabels[detectorID == 2 ? 1 : 0][species];
+}
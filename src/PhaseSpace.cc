@@ -0,0 +1,70 @@
+#include "PhaseSpace.hh"
+#include "PhaseSpaceReader.hh"
+
+#include "G4GenericMessenger.hh"
+#include "G4SystemOfUnits.hh"
+
+G4bool PhaseSpace::fgRecord = false;
+G4String PhaseSpace::fgOutputPrefix = "phasespace";
+G4double PhaseSpace::fgMinKineticEnergy = 0.;
+
+G4String PhaseSpace::fgReplayFile;
+PhaseSpaceReader* PhaseSpace::fgReader = nullptr;
+G4String PhaseSpace::fgOpenFile;
+std::atomic<std::size_t> PhaseSpace::fgNextEvent(0);
+
+void PhaseSpace::PrepareReplay()
+{
+  if (!IsReplaying()) return;
+
+  if (!fgReader) fgReader = new PhaseSpaceReader();
+  if (fgOpenFile != fgReplayFile || !fgReader->IsOpen()) {
+    fgOpenFile.clear();
+    if (!fgReader->Open(fgReplayFile)) {
+      G4Exception("PhaseSpace::PrepareReplay", "Tungsten0005", FatalException,
+                  ("Cannot replay phase-space file " + fgReplayFile).c_str());
+      return;
+    }
+    fgOpenFile = fgReplayFile;
+    G4cout << "Replaying " << fgReader->GetNumberOfEvents() << " events ("
+           << fgReader->GetNumberOfRecords() << " particles) from "
+           << fgReplayFile << G4endl;
+  }
+  fgNextEvent = 0;
+}
+
+G4bool PhaseSpace::NextEvent(std::size_t& index)
+{
+  index = fgNextEvent.fetch_add(1, std::memory_order_relaxed);
+  return fgReader && index < fgReader->GetNumberOfEvents();
+}
+
+G4GenericMessenger* PhaseSpace::CreateMessenger()
+{
+  auto* messenger = new G4GenericMessenger(nullptr, "/tungsten/phasespace/",
+                                           "Two-stage running via a phase-space file");
+
+  // Settings shared by all threads, so the commands stay on the master
+  messenger->DeclareProperty("record", fgRecord,
+                             "Stage 1: write the particles leaving the tungsten block")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclareProperty("output", fgOutputPrefix,
+                             "Phase-space files are named <prefix><runID>.phsp")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclarePropertyWithUnit("minEkine", "MeV", fgMinKineticEnergy,
+                                     "Only record particles above this kinetic energy")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclareProperty("replay", fgReplayFile,
+                             "Stage 2: generate events from this phase-space file "
+                             "(none: back to the proton gun)")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  return messenger;
+}
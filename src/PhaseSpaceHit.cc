@@ -0,0 +1,12 @@
+#include "PhaseSpaceHit.hh"
+
+G4ThreadLocal G4Allocator<PhaseSpaceHit>* PhaseSpaceHitAllocator = nullptr;
+
+void PhaseSpaceHit::Print()
+{
+  G4cout << "Tungsten exit: PDG " << fRecord.pdgCode
+         << ", E = " << fRecord.kineticEnergy << " MeV"
+         << ", position (" << fRecord.position[0] << ", " << fRecord.position[1]
+         << ", " << fRecord.position[2] << ") mm"
+         << ", weight " << fRecord.weight << G4endl;
+}
@@ -0,0 +1,80 @@
+#include "PhaseSpaceReader.hh"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+PhaseSpaceReader::PhaseSpaceReader()
+: fMapping(nullptr),
+  fMappingSize(0),
+  fRecords(nullptr),
+  fNumberOfRecords(0)
+{}
+
+PhaseSpaceReader::~PhaseSpaceReader()
+{
+  Close();
+}
+
+G4bool PhaseSpaceReader::Open(const G4String& fileName)
+{
+  Close();
+
+  const int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) {
+    G4cerr << "ERROR: Could not open phase-space file " << fileName << G4endl;
+    return false;
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) != 0
+      || static_cast<std::size_t>(info.st_size) < PhaseSpaceFormat::kHeaderSize) {
+    G4cerr << "ERROR: " << fileName << " is not a phase-space file" << G4endl;
+    ::close(fd);
+    return false;
+  }
+
+  fMappingSize = info.st_size;
+  void* mapping = ::mmap(nullptr, fMappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    G4cerr << "ERROR: Could not map phase-space file " << fileName << G4endl;
+    return false;
+  }
+  fMapping = mapping;
+
+  const char* bytes = static_cast<const char*>(fMapping);
+  std::uint32_t version = 0;
+  std::memcpy(&version, bytes + sizeof(PhaseSpaceFormat::kMagic), sizeof(version));
+  if (std::memcmp(bytes, PhaseSpaceFormat::kMagic, sizeof(PhaseSpaceFormat::kMagic)) != 0
+      || version != PhaseSpaceFormat::kVersion) {
+    G4cerr << "ERROR: " << fileName << " is not a version "
+           << PhaseSpaceFormat::kVersion << " phase-space file" << G4endl;
+    Close();
+    return false;
+  }
+
+  // The whole file is streamed once per run; let the kernel read ahead
+  ::madvise(fMapping, fMappingSize, MADV_SEQUENTIAL);
+
+  fRecords = reinterpret_cast<const PhaseSpaceRecord*>(bytes + PhaseSpaceFormat::kHeaderSize);
+  fNumberOfRecords = (fMappingSize - PhaseSpaceFormat::kHeaderSize)/sizeof(PhaseSpaceRecord);
+
+  // Events are runs of rows with the same event ID
+  for (std::size_t i = 0; i < fNumberOfRecords; ++i) {
+    if (i == 0 || fRecords[i].eventID != fRecords[i-1].eventID) fEventStarts.push_back(i);
+  }
+  return true;
+}
+
+void PhaseSpaceReader::Close()
+{
+  if (fMapping) ::munmap(fMapping, fMappingSize);
+  fMapping = nullptr;
+  fMappingSize = 0;
+  fRecords = nullptr;
+  fNumberOfRecords = 0;
+  fEventStarts.clear();
+}
@@ -0,0 +1,66 @@
+#include "PhaseSpaceWriter.hh"
+
+namespace
+{
+  void WriteHeader(std::ofstream& file)
+  {
+    file.write(PhaseSpaceFormat::kMagic, sizeof(PhaseSpaceFormat::kMagic));
+    file.write(reinterpret_cast<const char*>(&PhaseSpaceFormat::kVersion),
+               sizeof(PhaseSpaceFormat::kVersion));
+  }
+}
+
+PhaseSpaceWriter::PhaseSpaceWriter()
+{
+  fBuffer.reserve(kBufferSize);
+}
+
+PhaseSpaceWriter::~PhaseSpaceWriter()
+{
+  Close();
+}
+
+G4bool PhaseSpaceWriter::Open(const G4String& fileName)
+{
+  Close();
+
+  fFile.open(fileName, std::ios::binary | std::ios::trunc);
+  if (!fFile.is_open()) return false;
+
+  WriteHeader(fFile);
+  return true;
+}
+
+void PhaseSpaceWriter::Close()
+{
+  if (!fFile.is_open()) return;
+  Flush();
+  fFile.close();
+}
+
+void PhaseSpaceWriter::Flush()
+{
+  fFile.write(reinterpret_cast<const char*>(fBuffer.data()),
+              fBuffer.size()*sizeof(PhaseSpaceRecord));
+  fBuffer.clear();
+}
+
+G4bool PhaseSpaceWriter::Concatenate(const std::vector<G4String>& inputs,
+                                     const G4String& output)
+{
+  std::ofstream out(output, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) return false;
+  WriteHeader(out);
+
+  std::vector<char> buffer(kBufferSize*sizeof(PhaseSpaceRecord));
+  for (const G4String& input : inputs) {
+    std::ifstream in(input, std::ios::binary);
+    if (!in.is_open()) return false;
+    in.seekg(PhaseSpaceFormat::kHeaderSize);
+    // A worker without events leaves a header-only file
+    while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0) {
+      out.write(buffer.data(), in.gcount());
+    }
+  }
+  return static_cast<G4bool>(out);
+}
@@ -2,78 +2,286 @@
 
 #include "G4DecayPhysics.hh"
 #include "G4EmStandardPhysics.hh"
+#include "G4EmStandardPhysics_option1.hh"
 #include "G4EmExtraPhysics.hh"
 #include "G4HadronElasticPhysics.hh"
 #include "G4HadronPhysicsFTFP_BERT.hh"
 #include "G4StoppingPhysics.hh"
 #include "G4IonPhysics.hh"
 #include "G4RadioactiveDecayPhysics.hh"
+#include "G4StepLimiterPhysics.hh"
+#include "G4GenericBiasingPhysics.hh"
+#include "G4StateManager.hh"
+#include "PionDecayBiasingOperator.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4ProductionCuts.hh"
 #include "G4ProductionCutsTable.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4ProcessManager.hh"
 #include "G4ParticleTypes.hh"
 #include "G4ParticleTable.hh"
 #include "G4UnitsTable.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Threading.hh"
+#include "G4Version.hh"
 
-PhysicsList::PhysicsList() 
-: G4VModularPhysicsList()
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
 {
-  // Default cut value
-  SetDefaultCutValue(1.0*mm);
+  // Marker written after a complete store, so a job that died halfway
+  // through writing the tables never leaves a cache that looks valid
+  const char* const kCacheMarker = "complete";
+
+  // FNV-1a, enough to tell configurations apart in directory names
+  std::string HashKey(const G4String& text)
+  {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : text) {
+      hash ^= c;
+      hash *= 1099511628211ULL;
+    }
+    std::ostringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return key.str();
+  }
+}
+
+PhysicsList::PhysicsList(const G4String& profile)
+: G4VModularPhysicsList(),
+  fProfile(kFull),
+  fBiasingPhysics(nullptr),
+  fStoreCache(false),
+  fMessenger(nullptr)
+{
+  // Range cut outside the target: nothing produced in the air or the
+  // detectors matters for the muon/pion yield (/run/setCut changes it)
+  SetDefaultCutValue(1.0*m);
+
+  // The full list is always registered first: the kernel constructs the
+  // particles of every constructor when the list is handed over, so a
+  // leaner profile can only remove or replace constructors afterwards.
 
   // EM Physics
   RegisterPhysics(new G4EmStandardPhysics());
-  RegisterPhysics(new G4EmExtraPhysics());
+  fEmExtraPhysics = new G4EmExtraPhysics();
+  RegisterPhysics(fEmExtraPhysics);
   
   // Decay Physics
   RegisterPhysics(new G4DecayPhysics());
   
   // Radioactive decay
-  RegisterPhysics(new G4RadioactiveDecayPhysics());
+  fRadioactiveDecayPhysics = new G4RadioactiveDecayPhysics();
+  RegisterPhysics(fRadioactiveDecayPhysics);
   
   // Hadron Elastic Physics
-  RegisterPhysics(new G4HadronElasticPhysics());
+  fHadronElasticPhysics = new G4HadronElasticPhysics();
+  RegisterPhysics(fHadronElasticPhysics);
   
   // Hadron Physics - handles inelastic interactions
   RegisterPhysics(new G4HadronPhysicsFTFP_BERT());
   
   // Stopping Physics
-  RegisterPhysics(new G4StoppingPhysics());
+  fStoppingPhysics = new G4StoppingPhysics();
+  RegisterPhysics(fStoppingPhysics);
   
   // Ion Physics
-  RegisterPhysics(new G4IonPhysics());
+  fIonPhysics = new G4IonPhysics();
+  RegisterPhysics(fIonPhysics);
+
+  // G4UserSpecialCuts, for the kinetic-energy thresholds in TrackingCuts
+  RegisterPhysics(new G4StepLimiterPhysics());
+
+  SetProfile(profile);
+  DefineCommands();
 }
 
 PhysicsList::~PhysicsList()
 {
+  delete fMessenger;
+}
+
+G4bool PhysicsList::ParseProfile(const G4String& name, Profile& profile)
+{
+  if      (name == "full")       profile = kFull;
+  else if (name == "production") profile = kProduction;
+  else if (name == "fast")       profile = kFast;
+  else return false;
+  return true;
+}
+
+void PhysicsList::SetProfile(const G4String& name)
+{
+  Profile profile;
+  if (!ParseProfile(name, profile)) {
+    G4Exception("PhysicsList::SetProfile", "Tungsten0002", JustWarning,
+                ("Unknown physics profile " + name + ", keeping the current one").c_str());
+    return;
+  }
+  if (profile == fProfile) return;
+  if (profile < fProfile) {
+    // Removed constructors cannot be put back once the particles exist
+    G4Exception("PhysicsList::SetProfile", "Tungsten0003", JustWarning,
+                ("Cannot go back to the " + name + " profile; "
+                 "use --physics " + name + " on the command line").c_str());
+    return;
+  }
+
+  if (fProfile < kProduction) {
+    // The detector counts come from particles in flight. Without stopping
+    // physics, a stopped pi- or mu- decays instead of being captured, so
+    // the "Produced" muon counts do change.
+    for (G4VPhysicsConstructor* physics : { fEmExtraPhysics, fRadioactiveDecayPhysics,
+                                            fStoppingPhysics, fIonPhysics }) {
+      RemovePhysics(physics);
+      delete physics;
+    }
+  }
+  if (profile == kFast) {
+    // Faster EM option and no hadron elastic scattering: changes the
+    // yields slightly, check with scripts/physics_benchmark.sh
+    ReplacePhysics(new G4EmStandardPhysics_option1());
+    RemovePhysics(fHadronElasticPhysics);
+    delete fHadronElasticPhysics;
+  }
+  fProfile = profile;
+
+  G4cout << "Physics profile: " << name << G4endl;
+}
+
+void PhysicsList::SetPionDecayBias(G4double factor)
+{
+  if (factor > 1. && !fBiasingPhysics) {
+    if (G4StateManager::GetStateManager()->GetCurrentState() != G4State_PreInit) {
+      G4Exception("PhysicsList::SetPionDecayBias", "Tungsten0004", JustWarning,
+                  "Pion-decay biasing must be enabled before /run/initialize");
+      return;
+    }
+    auto* biasingPhysics = new G4GenericBiasingPhysics();
+    biasingPhysics->PhysicsBias("pi+", { "Decay" });
+    biasingPhysics->PhysicsBias("pi-", { "Decay" });
+    RegisterPhysics(biasingPhysics);
+    fBiasingPhysics = biasingPhysics;
+  }
+  PionDecayBiasingOperator::SetDecayFactor(factor);
+
+  G4cout << "Pion decay biasing: factor " << factor
+         << (factor > 1. ? "" : " (off)") << G4endl;
+}
+
+void PhysicsList::DefineCommands()
+{
+  fMessenger = new G4GenericMessenger(this, "/tungsten/physics/", "Physics list control");
+
+  // The list is shared by all threads and fixed at /run/initialize
+  fMessenger->DeclareMethod("profile", &PhysicsList::SetProfile,
+                            "full: everything; production: no EM extra, radioactive decay, "
+                            "ion or stopping physics; fast: production with EM option1 "
+                            "and no hadron elastic")
+    .SetCandidates("full production fast")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+
+  // The factor is read by the per-thread operators, so it can change
+  // between runs once biasing was enabled before /run/initialize
+  fMessenger->DeclareMethod("biasPionDecay", &PhysicsList::SetPionDecayBias,
+                            "Multiply the pi+- decay rate in the solenoid envelope "
+                            "by this factor (1: analog); hits carry the weights")
+    .SetParameterName("factor", false)
+    .SetRange("factor >= 1")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclareMethod("cacheDir", &PhysicsList::SetCacheDirectory,
+                            "Store the physics tables in this directory and retrieve "
+                            "them in later jobs with the same list and cuts (empty: off)")
+    .SetParameterName("directory", true)
+    .SetDefaultValue("")
+    .SetStates(G4State_PreInit)
+    .SetToBeBroadcasted(false);
+}
+
+G4String PhysicsList::GetConfigurationDescription() const
+{
+  // Everything that goes into the tables: the Geant4 version, the
+  // constructors (profile and biasing) and the range cuts. The materials
+  // are fixed in DetectorConstruction; Geant4 itself rejects a stored cuts
+  // table that does not match the current couples, and rebuilds.
+  std::ostringstream description;
+  description << "Geant4 " << G4VERSION_NUMBER << "\n";
+  for (G4int i = 0; GetPhysics(i) != nullptr; ++i) {
+    description << "physics " << GetPhysics(i)->GetPhysicsName() << "\n";
+  }
+  description << "cut default " << GetDefaultCutValue()/mm << " mm\n";
+  description << "cut Tungsten " << GetTungstenCutValue()/mm << " mm\n";
+  return description.str();
+}
+
+void PhysicsList::SetUpTableCache()
+{
+  const G4String description = GetConfigurationDescription();
+  fCachePath = fCacheDirectory + "/" + HashKey(description);
+
+  if (std::filesystem::exists(fCachePath + "/" + kCacheMarker)) {
+    SetPhysicsTableRetrieved(fCachePath);
+    fStoreCache = false;
+    G4cout << "Physics tables: retrieving from " << fCachePath << G4endl;
+  }
+  else {
+    fStoreCache = true;
+    G4cout << "Physics tables: not cached yet, storing to " << fCachePath
+           << " after the first run starts" << G4endl;
+  }
+}
+
+void PhysicsList::StoreTableCache()
+{
+  if (!fStoreCache) return;
+  fStoreCache = false;
+
+  std::error_code error;
+  std::filesystem::create_directories(fCachePath, error);
+  if (error || !StorePhysicsTable(fCachePath)) {
+    G4cerr << "ERROR: Could not store the physics tables in " << fCachePath << G4endl;
+    return;
+  }
+
+  std::ofstream marker(fCachePath + "/" + kCacheMarker);
+  marker << GetConfigurationDescription();
+  G4cout << "Physics tables: stored in " << fCachePath << G4endl;
+}
+
+G4double PhysicsList::GetTungstenCutValue() const
+{
+  const G4Region* region = G4RegionStore::GetInstance()->GetRegion("Tungsten", false);
+  const G4ProductionCuts* cuts = region ? region->GetProductionCuts() : nullptr;
+  return cuts ? cuts->GetProductionCut(0) : GetDefaultCutValue();
 }
 
 void PhysicsList::SetCuts()
 {
-  // Call the base class method first
+  // Coarse range cuts (the default value) for the air and the detectors
   G4VModularPhysicsList::SetCuts();
 
-  // Set energy threshold to 8 GeV for neutrons, electrons, and photons
-  const G4double energyThreshold = 8.0 * GeV;
-  
-  // Set energy thresholds using particle names
-  G4cout << "Setting energy threshold for neutrons: " << energyThreshold/GeV << " GeV" << G4endl;
-  SetCutValue(energyThreshold, "neutron");
-  
-  G4cout << "Setting energy threshold for electrons: " << energyThreshold/GeV << " GeV" << G4endl;
-  SetCutValue(energyThreshold, "e-");
-  
-  G4cout << "Setting energy threshold for photons: " << energyThreshold/GeV << " GeV" << G4endl;
-  SetCutValue(energyThreshold, "gamma");
-  
-  // Print summary
+  // The fine cuts of the tungsten target belong to its region, which
+  // DetectorConstruction creates with them; /run/setCutForRegion Tungsten
+  // <value> changes them in place.
   G4cout << "\n----------------------------------------------------------" << G4endl;
-  G4cout << "Physics List: Energy threshold for neutrons, electrons," << G4endl;
-  G4cout << "and photons set to " << energyThreshold/GeV << " GeV" << G4endl;
-  G4cout << "Only particles with energy > 8 GeV will be tracked" << G4endl;
+  G4cout << "Physics List: range cuts " << G4BestUnit(GetDefaultCutValue(), "Length")
+         << " (default region), " << G4BestUnit(GetTungstenCutValue(), "Length")
+         << " (Tungsten region)" << G4endl;
+  G4cout << "Kinetic-energy tracking thresholds: /tungsten/cuts/" << G4endl;
   G4cout << "----------------------------------------------------------\n" << G4endl;
-  
+
   // Dump the cuts table for reference
   DumpCutValuesTable();
-}
\ No newline at end of file
+
+  // The tables are built (or retrieved) by the master only
+  if (!fCacheDirectory.empty() && G4Threading::IsMasterThread()) SetUpTableCache();
+}
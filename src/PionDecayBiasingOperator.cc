@@ -0,0 +1,80 @@
+#include "PionDecayBiasingOperator.hh"
+
+#include "G4BiasingProcessInterface.hh"
+#include "G4BiasingProcessSharedData.hh"
+#include "G4BOptnChangeCrossSection.hh"
+#include "G4PionPlus.hh"
+#include "G4PionMinus.hh"
+#include "G4ProcessManager.hh"
+#include "G4Track.hh"
+
+G4double PionDecayBiasingOperator::fgDecayFactor = 1.;
+
+PionDecayBiasingOperator::PionDecayBiasingOperator()
+: G4VBiasingOperator("PionDecayBiasing")
+{}
+
+PionDecayBiasingOperator::~PionDecayBiasingOperator()
+{
+  for (auto& entry : fOperations) delete entry.second;
+}
+
+void PionDecayBiasingOperator::StartRun()
+{
+  // The wrapped processes exist once the physics is built; set up once
+  if (!fOperations.empty()) return;
+
+  for (const G4ParticleDefinition* pion : { G4PionPlus::Definition(), G4PionMinus::Definition() }) {
+    const G4BiasingProcessSharedData* sharedData
+      = G4BiasingProcessInterface::GetSharedData(pion->GetProcessManager());
+    if (!sharedData) continue;
+
+    for (const G4BiasingProcessInterface* wrapper : sharedData->GetPhysicsBiasingProcessInterfaces()) {
+      const G4String name = "XSchange-" + pion->GetParticleName() + "-"
+                            + wrapper->GetWrappedProcess()->GetProcessName();
+      fOperations[wrapper] = new G4BOptnChangeCrossSection(name);
+    }
+  }
+}
+
+G4VBiasingOperation* PionDecayBiasingOperator::ProposeOccurenceBiasingOperation(
+  const G4Track*, const G4BiasingProcessInterface* callingProcess)
+{
+  if (fgDecayFactor <= 1.) return nullptr;
+
+  auto entry = fOperations.find(callingProcess);
+  if (entry == fOperations.end()) return nullptr;
+
+  // Analog decay length of this step (c tau beta gamma for a pion in flight)
+  const G4double analogLength = callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  if (analogLength > DBL_MAX/10.) return nullptr;
+  const G4double biasedCrossSection = fgDecayFactor/analogLength;
+
+  G4BOptnChangeCrossSection* operation = entry->second;
+  const G4VBiasingOperation* previous = callingProcess->GetPreviousOccurenceBiasingOperation();
+
+  if (previous == nullptr || operation->GetInteractionOccured()) {
+    // New track or the biased decay happened: sample a fresh decay point
+    operation->SetBiasedCrossSection(biasedCrossSection);
+    operation->Sample();
+  } else {
+    // Still flying: consume the last step, then follow the new cross section
+    operation->UpdateForStep(callingProcess->GetPreviousStepSize());
+    operation->SetBiasedCrossSection(biasedCrossSection);
+    operation->UpdateForStep(0.);
+  }
+  return operation;
+}
+
+void PionDecayBiasingOperator::OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                                                G4BiasingAppliedCase,
+                                                G4VBiasingOperation* occurenceOperationApplied,
+                                                G4double,
+                                                G4VBiasingOperation*,
+                                                const G4VParticleChange*)
+{
+  auto entry = fOperations.find(callingProcess);
+  if (entry != fOperations.end() && entry->second == occurenceOperationApplied) {
+    entry->second->SetInteractionOccured();
+  }
+}
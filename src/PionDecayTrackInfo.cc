@@ -0,0 +1,13 @@
+#include "PionDecayTrackInfo.hh"
+#include "ParticleClassifier.hh"
+#include "G4SystemOfUnits.hh"
+
+G4ThreadLocal G4Allocator<PionDecayTrackInfo>* PionDecayTrackInfoAllocator = nullptr;
+
+void PionDecayTrackInfo::Print() const
+{
+  auto species = static_cast<ParticleClassifier::Species>(fParentSpecies);
+  G4cout << "From " << ParticleClassifier::GetName(species)
+         << " decay (E = " << fParentEnergy/MeV << " MeV) at z = "
+         << fDecayZ/mm << " mm" << G4endl;
+}
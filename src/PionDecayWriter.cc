@@ -0,0 +1,66 @@
+#include "PionDecayWriter.hh"
+
+namespace
+{
+  void WriteHeader(std::ofstream& file)
+  {
+    file.write(PionDecayFormat::kMagic, sizeof(PionDecayFormat::kMagic));
+    file.write(reinterpret_cast<const char*>(&PionDecayFormat::kVersion),
+               sizeof(PionDecayFormat::kVersion));
+  }
+}
+
+PionDecayWriter::PionDecayWriter()
+{
+  fBuffer.reserve(kBufferSize);
+}
+
+PionDecayWriter::~PionDecayWriter()
+{
+  Close();
+}
+
+G4bool PionDecayWriter::Open(const G4String& fileName)
+{
+  Close();
+
+  fFile.open(fileName, std::ios::binary | std::ios::trunc);
+  if (!fFile.is_open()) return false;
+
+  WriteHeader(fFile);
+  return true;
+}
+
+void PionDecayWriter::Close()
+{
+  if (!fFile.is_open()) return;
+  Flush();
+  fFile.close();
+}
+
+void PionDecayWriter::Flush()
+{
+  fFile.write(reinterpret_cast<const char*>(fBuffer.data()),
+              fBuffer.size()*sizeof(PionDecayRecord));
+  fBuffer.clear();
+}
+
+G4bool PionDecayWriter::Concatenate(const std::vector<G4String>& inputs,
+                                     const G4String& output)
+{
+  std::ofstream out(output, std::ios::binary | std::ios::trunc);
+  if (!out.is_open()) return false;
+  WriteHeader(out);
+
+  std::vector<char> buffer(kBufferSize*sizeof(PionDecayRecord));
+  for (const G4String& input : inputs) {
+    std::ifstream in(input, std::ios::binary);
+    if (!in.is_open()) return false;
+    in.seekg(PionDecayFormat::kHeaderSize);
+    // A worker without decays leaves a header-only file
+    while (in.read(buffer.data(), buffer.size()) || in.gcount() > 0) {
+      out.write(buffer.data(), in.gcount());
+    }
+  }
+  return static_cast<G4bool>(out);
+}
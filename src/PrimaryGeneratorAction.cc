@@ -1,8 +1,15 @@
 #include "PrimaryGeneratorAction.hh"
+#include "PhaseSpace.hh"
+#include "PhaseSpaceReader.hh"
 
 #include "G4ParticleGun.hh"
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
+#include "G4IonTable.hh"
+#include "G4PrimaryVertex.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4Event.hh"
+#include "G4RunManager.hh"
 #include "G4SystemOfUnits.hh"
 #include "Randomize.hh"
 
@@ -29,6 +36,11 @@ PrimaryGeneratorAction::~PrimaryGeneratorAction()
 
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 {
+  if (PhaseSpace::IsReplaying()) {
+    GenerateFromPhaseSpace(anEvent);
+    return;
+  }
+
   // Set beam direction along the z-axis (towards the tungsten block)
   fParticleGun->SetParticleMomentumDirection(G4ThreeVector(0., 0., 1.));
   
@@ -37,4 +49,41 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 
   // Generate the primary vertex
   fParticleGun->GeneratePrimaryVertex(anEvent);
-}
\ No newline at end of file
+}
+
+void PrimaryGeneratorAction::GenerateFromPhaseSpace(G4Event* event)
+{
+  std::size_t index = 0;
+  if (!PhaseSpace::NextEvent(index)) {
+    G4ExceptionDescription msg;
+    msg << "Phase-space file has no events left (event " << event->GetEventID()
+        << "); aborting the run.";
+    G4Exception("PrimaryGeneratorAction::GenerateFromPhaseSpace", "Tungsten0006",
+                JustWarning, msg);
+    G4RunManager::GetRunManager()->AbortRun(true);
+    return;
+  }
+
+  std::size_t nofRecords = 0;
+  const PhaseSpaceRecord* records = PhaseSpace::GetReader()->GetEvent(index, nofRecords);
+  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+
+  for (std::size_t i = 0; i < nofRecords; ++i) {
+    const PhaseSpaceRecord& record = records[i];
+    if (record.pdgCode == 0) continue;  // stage-1 event without exits
+
+    G4ParticleDefinition* particle = particleTable->FindParticle(record.pdgCode);
+    if (!particle) particle = G4IonTable::GetIonTable()->GetIon(record.pdgCode);
+    if (!particle) continue;
+
+    auto* vertex = new G4PrimaryVertex(record.position[0]*mm, record.position[1]*mm,
+                                       record.position[2]*mm, 0.);
+    auto* primary = new G4PrimaryParticle(particle);
+    primary->SetKineticEnergy(record.kineticEnergy*MeV);
+    primary->SetMomentumDirection(G4ThreeVector(record.direction[0], record.direction[1],
+                                                record.direction[2]));
+    primary->SetWeight(record.weight);
+    vertex->SetPrimary(primary);
+    event->AddPrimaryVertex(vertex);
+  }
+}
@@ -1,73 +1,363 @@
 #include "RunAction.hh"
+#include "ParticleClassifier.hh"
+#include "Logger.hh"
+#include "MemoryUsage.hh"
+#include "DetectorConstruction.hh"
+#include "ElectricFieldSetup.hh"
+#include "PionDecayBiasingOperator.hh"
+#include "PhaseSpace.hh"
+#include "ParameterScan.hh"
+#include "PhysicsList.hh"
+#include "Histograms.hh"
+#include "Telemetry.hh"
+#include "HitArena.hh"
+#ifdef TUNGSTEN_STEP_PROFILER
+#include "StepProfiler.hh"
+#endif
 
 #include "G4Run.hh"
 #include "G4RunManager.hh"
+#include "G4RunManagerKernel.hh"
+#include "G4AccumulableManager.hh"
+#include "G4AutoLock.hh"
+#include "G4Threading.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4ParticleTable.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4UnitsTable.hh"
+#include "G4GenericMessenger.hh"
 
-RunAction::RunAction()
-: G4UserRunAction()
-{}
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
 
-RunAction::~RunAction()
+namespace
 {
-  if (fOutputFile.is_open()) {
-    fOutputFile.close();
-  }
+  G4Mutex shardMutex = G4MUTEX_INITIALIZER;
+
 }
 
+std::vector<G4String> RunAction::fgShardFiles;
+std::vector<G4String> RunAction::fgPhaseSpaceShards;
+std::vector<G4String> RunAction::fgDecayShards;
+G4String RunAction::fgOutputPrefix = "particle_data";
+G4bool RunAction::fgWriteHits = false;
+G4bool RunAction::fgWriteDecays = false;
+G4String RunAction::fgSummaryPrefix = "";
+
+RunAction::RunAction()
+: G4UserRunAction(),
+  fNumberOfSteps(0)
+{
+  G4AccumulableManager::Instance()->Register(&fStatistics);
+  G4AccumulableManager::Instance()->Register(&fKilledTracks);
+  Histograms::Book();
+}
+
+RunAction::~RunAction()
+{}
+
 void RunAction::BeginOfRunAction(const G4Run* run)
 {
-  G4cout << "### Run " << run->GetRunID() << " start." << G4endl;
+  TUNGSTEN_LOG(Logger::kRun, "### Run " << run->GetRunID() << " start.");
   fSecondaryParticles.clear();
-  fParticleCounts.clear();
-  
-  // Open Excel file for particle data
-  G4String fileName = "particle_data" + std::to_string(run->GetRunID()) + ".csv";
-  fOutputFile.open(fileName);
+  fNumberOfSteps = 0;
+  G4AccumulableManager::Instance()->Reset();
+
+  // Particle/process lookup tables for this thread's stepping action
+  ParticleClassifier::Instance()->Build();
+  HitArena::Instance()->BeginOfRun();
+  ElectricFieldSetup* fieldSetup = GetFieldSetup();
+  if (fieldSetup) fieldSetup->ResetNumberOfFieldCalls();
+  fTimer.Start();
+
+  if (IsMaster()) {
+    ParameterScan::BeginOfRun(run);
+
+    // The master has built the tables by now; cache them if asked to
+    auto physicsList = dynamic_cast<PhysicsList*>(
+      G4RunManagerKernel::GetRunManagerKernel()->GetPhysicsList());
+    if (physicsList) physicsList->StoreTableCache();
+  }
+
+  // Stage 2: every run starts again from the first stage-1 event
+  if (IsMaster() && PhaseSpace::IsReplaying()) PhaseSpace::PrepareReplay();
+
+  // Every thread opens the histogram file; only the master writes to it
+  Histograms::OpenFile(run->GetRunID());
+
+  Telemetry::BeginOfRun();
+  if (IsMaster()) Telemetry::StartSampling(run->GetRunID(), run->GetNumberOfEventToBeProcessed());
+
+#ifdef TUNGSTEN_STEP_PROFILER
+  StepProfiler::BeginOfRun();
+#endif
   
-  // Write CSV header with more information
-  if (fOutputFile.is_open()) {
-    fOutputFile << "ParticleType,Energy" << std::endl;
-    G4cout << "Recording particle data to file: " << fileName << G4endl;
+  // In MT mode the master only merges the workers' files at the end of run
+  if (IsMaster() && G4Threading::IsMultithreadedApplication()) return;
+
+  // Open binary hit file (tungsten_hits2csv converts it to the old CSV layout).
+  // Each worker writes its own shard so threads never share a file.
+  if (fgWriteHits) {
+    G4String fileName = HitFileName(run->GetRunID());
+    if (!IsMaster()) {
+      fileName = fgOutputPrefix + std::to_string(run->GetRunID())
+                 + "_t" + std::to_string(G4Threading::G4GetThreadId()) + ".bin";
+    }
+    if (fHitWriter.Open(fileName)) {
+      if (!IsMaster()) {
+        G4AutoLock lock(&shardMutex);
+        fgShardFiles.push_back(fileName);
+      }
+      TUNGSTEN_LOG(Logger::kRun, "Recording particle data to file: " << fileName);
+    } else {
+      G4cerr << "ERROR: Could not open output file " << fileName << G4endl;
+    }
+  }
+
+  // Pion -> muon decay vertices, one shard per worker like the hits
+  if (fgWriteDecays) {
+    G4String decayName = DecayFileName(run->GetRunID());
+    if (!IsMaster()) {
+      decayName = fgOutputPrefix + "_decays" + std::to_string(run->GetRunID())
+                  + "_t" + std::to_string(G4Threading::G4GetThreadId()) + ".bin";
+    }
+    if (fDecayWriter.Open(decayName)) {
+      if (!IsMaster()) {
+        G4AutoLock lock(&shardMutex);
+        fgDecayShards.push_back(decayName);
+      }
+      TUNGSTEN_LOG(Logger::kRun, "Recording pion decays to file: " << decayName);
+    } else {
+      G4cerr << "ERROR: Could not open decay file " << decayName << G4endl;
+    }
+  }
+
+  if (!PhaseSpace::IsRecording()) return;
+
+  G4String phaseSpaceName = PhaseSpace::GetOutputPrefix() + std::to_string(run->GetRunID());
+  if (!IsMaster()) phaseSpaceName += "_t" + std::to_string(G4Threading::G4GetThreadId());
+  phaseSpaceName += ".phsp";
+  if (fPhaseSpaceWriter.Open(phaseSpaceName)) {
+    if (!IsMaster()) {
+      G4AutoLock lock(&shardMutex);
+      fgPhaseSpaceShards.push_back(phaseSpaceName);
+    }
+    TUNGSTEN_LOG(Logger::kRun, "Recording tungsten exits to file: " << phaseSpaceName);
   } else {
-    G4cerr << "ERROR: Could not open output file " << fileName << G4endl;
+    G4cerr << "ERROR: Could not open phase-space file " << phaseSpaceName << G4endl;
   }
 }
 
 void RunAction::EndOfRunAction(const G4Run* run)
 {
+  fTimer.Stop();
+  if (IsMaster()) Telemetry::StopSampling();
+
+  // Flush and close the hit file
+  if (fHitWriter.IsOpen()) {
+    fHitWriter.Close();
+    TUNGSTEN_LOG(Logger::kRun, "Particle data saved to hit file");
+  }
+  if (fPhaseSpaceWriter.IsOpen()) fPhaseSpaceWriter.Close();
+  if (fDecayWriter.IsOpen()) fDecayWriter.Close();
+
+  // Merge the workers' statistics and histograms into the master
+  G4AccumulableManager::Instance()->Merge();
+  Histograms::WriteFile();
+#ifdef TUNGSTEN_STEP_PROFILER
+  // The workers end their runs before the master, so its report is complete
+  StepProfiler::EndOfRun();
+  if (IsMaster()) StepProfiler::Report(run->GetRunID());
+#endif
+
+  // The workers have closed their shards by now; combine them in event order
+  if (IsMaster() && G4Threading::IsMultithreadedApplication()) {
+    if (fgWriteHits) MergeHitFiles(run->GetRunID());
+    if (PhaseSpace::IsRecording()) MergePhaseSpaceFiles(run->GetRunID());
+    if (fgWriteDecays) MergeDecayFiles(run->GetRunID());
+  }
+
+  // Per-point results and setup times of parameter scans
+  if (IsMaster()) ParameterScan::EndOfRun(run, fStatistics, fTimer.GetRealElapsed());
+
   G4int nofEvents = run->GetNumberOfEvent();
   if (nofEvents == 0) return;
-  
-  // Print simple particle summary
-  G4cout << "\n=== PARTICLE SUMMARY ===" << G4endl;
-  for (const auto& pair : fParticleCounts) {
-    G4cout << pair.first << ": " << pair.second << G4endl;
+
+  G4double seconds = fTimer.GetRealElapsed();
+
+  // Step throughput of this thread (the master does no stepping)
+  if (fNumberOfSteps > 0) {
+    ElectricFieldSetup* fieldSetup = GetFieldSetup();
+    G4long fieldCalls = fieldSetup ? fieldSetup->GetNumberOfFieldCalls() : 0;
+    TUNGSTEN_LOG(Logger::kRun, "\n=== STEP THROUGHPUT ==="
+                 << "\nSteps: " << fNumberOfSteps << " in " << seconds << " s ("
+                 << (seconds > 0. ? fNumberOfSteps/seconds : 0.) << " steps/s)"
+                 << "\nField calls: " << fieldCalls << " ("
+                 << G4double(fieldCalls)/fNumberOfSteps << " per step)"
+                 << "\n=======================");
+  }
+
+  // Hit buffer of the threads that tracked events
+  if (TUNGSTEN_LOG_ENABLED(Logger::kRun)
+      && (!IsMaster() || !G4Threading::IsMultithreadedApplication())) {
+    HitArena::Instance()->PrintReport();
   }
-  G4cout << "=========================" << G4endl;
   
-  // Close Excel file
-  if (fOutputFile.is_open()) {
-    fOutputFile.close();
-    G4cout << "Particle data saved to Excel file" << G4endl;
+  if (!IsMaster()) return;
+
+  // Wall-clock time of the whole run (parsed by scripts/scaling_benchmark.sh)
+  TUNGSTEN_LOG(Logger::kRun, "Run " << run->GetRunID() << ": " << nofEvents
+               << " events in " << seconds << " s ("
+               << (seconds > 0. ? nofEvents/seconds : 0.) << " events/s), peak RSS "
+               << MemoryUsage::GetPeakRSS() << " MB");
+
+  if (!fgSummaryPrefix.empty()) WriteSummary(run, seconds);
+
+  // Muon/pion totals, yields per proton and errors (all threads)
+  if (TUNGSTEN_LOG_ENABLED(Logger::kRun)) {
+    fStatistics.PrintSummary();
+    if (PionDecayBiasingOperator::GetDecayFactor() > 1.) {
+      G4cout << "Weighted yields: pi+- decay rate biased by a factor "
+             << PionDecayBiasingOperator::GetDecayFactor() << G4endl;
+    }
   }
+
+  if (StackingAction::GetPolicy().enabled && TUNGSTEN_LOG_ENABLED(Logger::kRun)) {
+    G4cout << "Tracks killed by the stacking policy:";
+    for (G4int i = 0; i < StackingAction::kNumberOfKillReasons; ++i) {
+      auto reason = static_cast<StackingAction::KillReason>(i);
+      G4cout << " " << StackingAction::GetKillReasonName(reason)
+             << " " << fKilledTracks.Get(reason);
+    }
+    G4cout << G4endl;
+  }
+}
+
+ElectricFieldSetup* RunAction::GetFieldSetup() const
+{
+  auto detector = static_cast<const DetectorConstruction*>(
+    G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+  return detector ? detector->GetFieldSetup() : nullptr;
 }
 
-void RunAction::RecordParticleToExcel(const G4String& name, 
-                                     const G4double& kineticEnergy)
+void RunAction::WriteSummary(const G4Run* run, G4double seconds) const
 {
-  if (fOutputFile.is_open()) {
-    G4int eventID = G4RunManager::GetRunManager()->GetCurrentEvent()->GetEventID();
-    
-    // Write to Excel with enhanced information
-    fOutputFile
-                << name << ","
-                << kineticEnergy/MeV<<std::endl;
+  const G4String fileName = fgSummaryPrefix + std::to_string(run->GetRunID()) + ".json";
+  std::ofstream file(fileName);
+  if (!file.is_open()) {
+    G4cerr << "ERROR: Could not open run summary " << fileName << G4endl;
+    return;
   }
-  
-  // Count this particle type for the summary
-  CountParticle(name);
-}
\ No newline at end of file
+
+  // One member per line, so shell tools can read it as well as JSON parsers
+  const G4int nofEvents = run->GetNumberOfEvent();
+  file << std::setprecision(10)
+       << "{\n  \"run\": " << run->GetRunID()
+       << ",\n  \"threads\": " << G4RunManager::GetRunManager()->GetNumberOfThreads()
+       << ",\n  \"seconds\": " << seconds
+       << ",\n  \"events_per_s\": " << (seconds > 0. ? nofEvents/seconds : 0.)
+       << ",\n  \"peak_rss_mb\": " << MemoryUsage::GetPeakRSS()
+       << ",\n";
+  fStatistics.WriteJson(file);
+  file << "\n}\n";
+
+  TUNGSTEN_LOG(Logger::kRun, "Run summary written to " << fileName);
+}
+
+G4String RunAction::HitFileName(G4int runID)
+{
+  return fgOutputPrefix + std::to_string(runID) + ".bin";
+}
+
+G4String RunAction::DecayFileName(G4int runID)
+{
+  return fgOutputPrefix + "_decays" + std::to_string(runID) + ".bin";
+}
+
+void RunAction::MergeHitFiles(G4int runID)
+{
+  std::vector<G4String> shards;
+  {
+    G4AutoLock lock(&shardMutex);
+    shards.swap(fgShardFiles);
+  }
+
+  G4String fileName = HitFileName(runID);
+  if (!HitWriter::MergeFiles(shards, fileName)) {
+    G4cerr << "ERROR: Could not merge worker hit files into " << fileName << G4endl;
+    return;
+  }
+  for (const G4String& shard : shards) std::remove(shard.c_str());
+
+  TUNGSTEN_LOG(Logger::kRun, "Merged " << shards.size()
+               << " worker hit files into " << fileName);
+}
+
+void RunAction::MergePhaseSpaceFiles(G4int runID)
+{
+  std::vector<G4String> shards;
+  {
+    G4AutoLock lock(&shardMutex);
+    shards.swap(fgPhaseSpaceShards);
+  }
+
+  G4String fileName = PhaseSpace::GetOutputPrefix() + std::to_string(runID) + ".phsp";
+  if (!PhaseSpaceWriter::Concatenate(shards, fileName)) {
+    G4cerr << "ERROR: Could not merge worker phase-space files into " << fileName << G4endl;
+    return;
+  }
+  for (const G4String& shard : shards) std::remove(shard.c_str());
+
+  TUNGSTEN_LOG(Logger::kRun, "Merged " << shards.size()
+               << " worker phase-space files into " << fileName);
+}
+
+void RunAction::MergeDecayFiles(G4int runID)
+{
+  std::vector<G4String> shards;
+  {
+    G4AutoLock lock(&shardMutex);
+    shards.swap(fgDecayShards);
+  }
+
+  // Rows carry their event ID, so the table does not need to be in event order
+  G4String fileName = DecayFileName(runID);
+  if (!PionDecayWriter::Concatenate(shards, fileName)) {
+    G4cerr << "ERROR: Could not merge worker decay files into " << fileName << G4endl;
+    return;
+  }
+  for (const G4String& shard : shards) std::remove(shard.c_str());
+
+  TUNGSTEN_LOG(Logger::kRun, "Merged " << shards.size()
+               << " worker decay files into " << fileName);
+}
+
+G4GenericMessenger* RunAction::CreateMessenger()
+{
+  auto* messenger = new G4GenericMessenger(nullptr, "/tungsten/output/", "Raw output files");
+
+  // Read by every thread at the start of a run, so the commands stay on the master
+  messenger->DeclareProperty("hits", fgWriteHits,
+                             "Write every detector hit to <prefix><runID>.bin")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclareProperty("decays", fgWriteDecays,
+                             "Write every pi -> mu decay to <prefix>_decays<runID>.bin")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclareProperty("summary", fgSummaryPrefix,
+                             "Write yields, energy moments, events/s and peak RSS "
+                             "of each run to <prefix><runID>.json")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclareProperty("prefix", fgOutputPrefix,
+                             "Hit files are named <prefix><runID>.bin")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  return messenger;
+}
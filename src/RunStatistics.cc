@@ -0,0 +1,177 @@
+#include "RunStatistics.hh"
+
+#include <cmath>
+#include <iomanip>
+
+namespace
+{
+  const G4String kLocationNames[RunStatistics::kNumberOfLocations] = {
+    "Produced", "Detector 1", "Detector 2"
+  };
+
+  // Keys of the run summary file
+  const G4String kLocationKeys[RunStatistics::kNumberOfLocations] = {
+    "produced", "detector1", "detector2"
+  };
+}
+
+void RunStatistics::EventTally::Reset()
+{
+  for (G4int l = 0; l < kNumberOfLocations; ++l) {
+    for (G4int s = 0; s < ParticleClassifier::kNumberOfSpecies; ++s) {
+      counts[l][s] = 0.;
+      entries[l][s] = 0;
+      energy[l][s] = 0.;
+      energySquares[l][s] = 0.;
+    }
+  }
+}
+
+RunStatistics::RunStatistics()
+: G4VAccumulable("RunStatistics")
+{
+  Reset();
+}
+
+void RunStatistics::AddEvent(const EventTally& tally)
+{
+  fNumberOfEvents++;
+  for (G4int l = 0; l < kNumberOfLocations; ++l) {
+    for (G4int s = 0; s < ParticleClassifier::kNumberOfSpecies; ++s) {
+      const G4double n = tally.counts[l][s];
+      fSum[l][s] += n;
+      fSumSquares[l][s] += n*n;
+      fEntries[l][s] += tally.entries[l][s];
+      fEnergy[l][s] += tally.energy[l][s];
+      fEnergySquares[l][s] += tally.energySquares[l][s];
+    }
+  }
+}
+
+G4double RunStatistics::GetYield(Location location,
+                                 ParticleClassifier::Species species) const
+{
+  if (fNumberOfEvents == 0) return 0.;
+  return fSum[location][species]/fNumberOfEvents;
+}
+
+G4double RunStatistics::GetYieldError(Location location,
+                                      ParticleClassifier::Species species) const
+{
+  if (fNumberOfEvents < 2) return 0.;
+  const G4double n = fNumberOfEvents;
+  const G4double mean = fSum[location][species]/n;
+  const G4double variance = (fSumSquares[location][species]/n - mean*mean)*n/(n - 1.);
+  return variance > 0. ? std::sqrt(variance/n) : 0.;
+}
+
+G4double RunStatistics::GetMeanEnergy(Location location,
+                                     ParticleClassifier::Species species) const
+{
+  const G4double sum = fSum[location][species];
+  return sum > 0. ? fEnergy[location][species]/sum : 0.;
+}
+
+G4double RunStatistics::GetEnergyRMS(Location location,
+                                    ParticleClassifier::Species species) const
+{
+  const G4double sum = fSum[location][species];
+  if (sum <= 0.) return 0.;
+  const G4double mean = fEnergy[location][species]/sum;
+  const G4double variance = fEnergySquares[location][species]/sum - mean*mean;
+  return variance > 0. ? std::sqrt(variance) : 0.;
+}
+
+G4double RunStatistics::GetMeanEnergyError(Location location,
+                                           ParticleClassifier::Species species) const
+{
+  const G4long entries = fEntries[location][species];
+  return entries > 1 ? GetEnergyRMS(location, species)/std::sqrt(G4double(entries)) : 0.;
+}
+
+G4double RunStatistics::GetEnergyRMSError(Location location,
+                                          ParticleClassifier::Species species) const
+{
+  const G4long entries = fEntries[location][species];
+  return entries > 1 ? GetEnergyRMS(location, species)/std::sqrt(2.*entries) : 0.;
+}
+
+void RunStatistics::Merge(const G4VAccumulable& other)
+{
+  const RunStatistics& stats = static_cast<const RunStatistics&>(other);
+  fNumberOfEvents += stats.fNumberOfEvents;
+  for (G4int l = 0; l < kNumberOfLocations; ++l) {
+    for (G4int s = 0; s < ParticleClassifier::kNumberOfSpecies; ++s) {
+      fSum[l][s] += stats.fSum[l][s];
+      fSumSquares[l][s] += stats.fSumSquares[l][s];
+      fEntries[l][s] += stats.fEntries[l][s];
+      fEnergy[l][s] += stats.fEnergy[l][s];
+      fEnergySquares[l][s] += stats.fEnergySquares[l][s];
+    }
+  }
+}
+
+void RunStatistics::Reset()
+{
+  fNumberOfEvents = 0;
+  for (G4int l = 0; l < kNumberOfLocations; ++l) {
+    for (G4int s = 0; s < ParticleClassifier::kNumberOfSpecies; ++s) {
+      fSum[l][s] = 0.;
+      fSumSquares[l][s] = 0.;
+      fEntries[l][s] = 0;
+      fEnergy[l][s] = 0.;
+      fEnergySquares[l][s] = 0.;
+    }
+  }
+}
+
+void RunStatistics::PrintSummary() const
+{
+  G4cout << "\n=== MUON/PION SUMMARY (" << fNumberOfEvents << " protons) ===" << G4endl;
+  G4cout << std::setw(12) << "Location" << std::setw(8) << "Type"
+         << std::setw(12) << "Total" << std::setw(16) << "Per proton"
+         << std::setw(14) << "Error" << std::setw(12) << "Entries" << G4endl;
+
+  for (G4int l = 0; l < kNumberOfLocations; ++l) {
+    const auto location = static_cast<Location>(l);
+    for (G4int s = 0; s < ParticleClassifier::kNumberOfSpecies; ++s) {
+      const auto species = static_cast<ParticleClassifier::Species>(s);
+      // pi0 never reaches the detectors as a track worth scoring
+      if (location != kProduced && species == ParticleClassifier::kPionZero) continue;
+
+      G4cout << std::setw(12) << GetLocationName(location)
+             << std::setw(8) << ParticleClassifier::GetName(species)
+             << std::setw(12) << GetTotal(location, species)
+             << std::setw(16) << GetYield(location, species)
+             << std::setw(14) << GetYieldError(location, species)
+             << std::setw(12) << GetEntries(location, species) << G4endl;
+    }
+  }
+  G4cout << "==============================================" << G4endl;
+}
+
+void RunStatistics::WriteJson(std::ostream& out) const
+{
+  out << "  \"events\": " << fNumberOfEvents;
+  for (G4int l = 0; l < kNumberOfLocations; ++l) {
+    const auto location = static_cast<Location>(l);
+    for (G4int s = 0; s < ParticleClassifier::kNumberOfSpecies; ++s) {
+      const auto species = static_cast<ParticleClassifier::Species>(s);
+      if (location != kProduced && species == ParticleClassifier::kPionZero) continue;
+
+      const G4String key = "\"" + kLocationKeys[l] + "." + ParticleClassifier::GetName(species) + ".";
+      out << ",\n  " << key << "entries\": " << GetEntries(location, species)
+          << ",\n  " << key << "yield\": " << GetYield(location, species)
+          << ",\n  " << key << "yield_error\": " << GetYieldError(location, species)
+          << ",\n  " << key << "mean_energy_mev\": " << GetMeanEnergy(location, species)
+          << ",\n  " << key << "mean_energy_error_mev\": " << GetMeanEnergyError(location, species)
+          << ",\n  " << key << "rms_energy_mev\": " << GetEnergyRMS(location, species)
+          << ",\n  " << key << "rms_energy_error_mev\": " << GetEnergyRMSError(location, species);
+    }
+  }
+}
+
+const G4String& RunStatistics::GetLocationName(Location location)
+{
+  return kLocationNames[location];
+}
@@ -0,0 +1,142 @@
+#include "StackingAction.hh"
+#include "RunAction.hh"
+#include "ParticleClassifier.hh"
+
+#include "G4Track.hh"
+#include "G4Gamma.hh"
+#include "G4Electron.hh"
+#include "G4Positron.hh"
+#include "G4Neutron.hh"
+#include "G4GenericMessenger.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <cmath>
+
+namespace
+{
+  const G4String kKillReasonNames[StackingAction::kNumberOfKillReasons] = {
+    "gamma", "e+-", "neutron", "fragment", "outside cone"
+  };
+}
+
+// Thresholds only apply once the policy is enabled; 180 deg keeps every direction
+StackingAction::Policy StackingAction::fgPolicy = {
+  false,        // enabled
+  100.0*MeV,    // gamma
+  100.0*MeV,    // e+-
+  100.0*MeV,    // neutron
+  500.0*MeV,    // fragment
+  180.0*deg     // acceptance cone
+};
+
+StackingAction::StackingAction(RunAction* runAction)
+: G4UserStackingAction(),
+  fRunAction(runAction),
+  fClassifier(ParticleClassifier::Instance()),
+  fGamma(G4Gamma::Definition()),
+  fElectron(G4Electron::Definition()),
+  fPositron(G4Positron::Definition()),
+  fNeutron(G4Neutron::Definition())
+{}
+
+StackingAction::~StackingAction()
+{}
+
+G4ClassificationOfNewTrack StackingAction::ClassifyNewTrack(const G4Track* track)
+{
+  if (!fgPolicy.enabled || track->GetParentID() == 0) return fUrgent;
+
+  const G4ParticleDefinition* particle = track->GetDefinition();
+  const ParticleClassifier::Species species = fClassifier->Classify(particle);
+  const G4double energy = track->GetKineticEnergy();
+
+  // Muons and pions are never killed and are tracked first. The 7 T field
+  // curls them back towards the axis, so no angular cut applies to them.
+  if (species != ParticleClassifier::kOther) return fUrgent;
+
+  if (fgPolicy.maxAngle < 180.0*deg
+      && track->GetMomentumDirection().z() < std::cos(fgPolicy.maxAngle)) {
+    return Kill(kKilledOutsideCone);
+  }
+
+  if (particle == fGamma) {
+    if (energy < fgPolicy.gammaThreshold) return Kill(kKilledGamma);
+  }
+  else if (particle == fElectron || particle == fPositron) {
+    if (energy < fgPolicy.electronThreshold) return Kill(kKilledElectron);
+  }
+  else if (particle == fNeutron) {
+    if (energy < fgPolicy.neutronThreshold) return Kill(kKilledNeutron);
+  }
+  else if (particle->GetBaryonNumber() > 1) {
+    if (energy < fgPolicy.fragmentThreshold) return Kill(kKilledFragment);
+  }
+  return fWaiting;
+}
+
+G4ClassificationOfNewTrack StackingAction::Kill(KillReason reason)
+{
+  fRunAction->CountKilledTrack(reason);
+  return fKill;
+}
+
+StackingAction::KillCounts::KillCounts()
+: G4VAccumulable("KilledTracks")
+{
+  Reset();
+}
+
+void StackingAction::KillCounts::Merge(const G4VAccumulable& other)
+{
+  const KillCounts& counts = static_cast<const KillCounts&>(other);
+  for (G4int i = 0; i < kNumberOfKillReasons; ++i) fCounts[i] += counts.fCounts[i];
+}
+
+void StackingAction::KillCounts::Reset()
+{
+  for (G4int i = 0; i < kNumberOfKillReasons; ++i) fCounts[i] = 0;
+}
+
+const G4String& StackingAction::GetKillReasonName(KillReason reason)
+{
+  return kKillReasonNames[reason];
+}
+
+G4GenericMessenger* StackingAction::CreateMessenger()
+{
+  auto* messenger = new G4GenericMessenger(nullptr, "/tungsten/stack/",
+                                           "Track-killing policy of the stacking action");
+  // The policy is shared by all threads, so the commands stay on the master
+
+  messenger->DeclareProperty("enable", fgPolicy.enabled,
+                             "Kill tracks that cannot reach the detectors")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclarePropertyWithUnit("gammaThreshold", "MeV", fgPolicy.gammaThreshold,
+                                     "Kill gammas below this kinetic energy")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclarePropertyWithUnit("electronThreshold", "MeV", fgPolicy.electronThreshold,
+                                     "Kill e- and e+ below this kinetic energy")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclarePropertyWithUnit("neutronThreshold", "MeV", fgPolicy.neutronThreshold,
+                                     "Kill neutrons below this kinetic energy")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclarePropertyWithUnit("fragmentThreshold", "MeV", fgPolicy.fragmentThreshold,
+                                     "Kill nuclear fragments (A > 1) below this kinetic energy")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclarePropertyWithUnit("maxAngle", "deg", fgPolicy.maxAngle,
+                                     "Kill secondaries further than this from +z (180 deg: off)")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  return messenger;
+}
@@ -0,0 +1,213 @@
+#include "StepProfiler.hh"
+#include "Logger.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4LogicalVolume.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4VProcess.hh"
+#include "G4EventManager.hh"
+#include "G4TrackingManager.hh"
+#include "G4GenericMessenger.hh"
+#include "G4AutoLock.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+  G4Mutex profileMutex = G4MUTEX_INITIALIZER;
+
+  // Merged table of the run, keyed by names: the process objects differ
+  // between threads
+  using NameKey = std::tuple<G4String, G4String, G4String>;
+  std::map<NameKey, StepProfiler::Entry> mergedTable;
+}
+
+G4ThreadLocal StepProfiler* StepProfiler::fgInstance = nullptr;
+G4bool StepProfiler::fgEnabled = false;
+G4int StepProfiler::fgTopN = 20;
+G4String StepProfiler::fgOutputPrefix = "step_profile";
+
+StepProfiler::StepProfiler()
+: G4SteppingVerbose(),
+  fActive(false),
+  fPreviousVerboseLevel(0)
+{
+  fgInstance = this;
+}
+
+StepProfiler::~StepProfiler()
+{
+  if (fgInstance == this) fgInstance = nullptr;
+}
+
+void StepProfiler::NewStep()
+{
+  if (fActive) fStepStart = std::chrono::steady_clock::now();
+}
+
+void StepProfiler::StepInfo()
+{
+  if (!fActive) return;
+  const auto elapsed = std::chrono::steady_clock::now() - fStepStart;
+
+  CopyState();
+  Key key { fStep->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume(),
+            fTrack->GetDefinition(),
+            fStep->GetPostStepPoint()->GetProcessDefinedStep() };
+  Entry& entry = fTable[key];
+  entry.steps++;
+  entry.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+}
+
+void StepProfiler::TrackingStarted()
+{
+  if (!fActive) return;
+
+  CopyState();
+  const G4VPhysicalVolume* volume = fTrack->GetVolume();
+  Key key { volume ? volume->GetLogicalVolume() : nullptr,
+            fTrack->GetDefinition(),
+            fTrack->GetCreatorProcess() };
+  fTable[key].tracks++;
+}
+
+void StepProfiler::Start()
+{
+  fTable.clear();
+  fActive = fgEnabled;
+  if (!fActive) return;
+
+  // The stepping manager only calls a stepping verbose above level 0.
+  // Set here, after the run's /tracking/verbose commands have been applied.
+  G4TrackingManager* trackingManager = G4EventManager::GetEventManager()->GetTrackingManager();
+  fPreviousVerboseLevel = trackingManager->GetVerboseLevel();
+  trackingManager->SetVerboseLevel(1);
+  SetSilent(1);
+}
+
+void StepProfiler::Stop()
+{
+  if (!fActive) return;
+  fActive = false;
+
+  G4EventManager::GetEventManager()->GetTrackingManager()->SetVerboseLevel(fPreviousVerboseLevel);
+  SetSilent(0);
+  Merge();
+}
+
+void StepProfiler::Merge()
+{
+  G4AutoLock lock(&profileMutex);
+  for (const auto& [key, entry] : fTable) {
+    NameKey names { key.volume ? key.volume->GetName() : G4String("none"),
+                    key.particle->GetParticleName(),
+                    key.process ? key.process->GetProcessName() : G4String("primary") };
+    Entry& merged = mergedTable[names];
+    merged.steps += entry.steps;
+    merged.tracks += entry.tracks;
+    merged.nanoseconds += entry.nanoseconds;
+  }
+  fTable.clear();
+}
+
+void StepProfiler::BeginOfRun()
+{
+  if (fgInstance) fgInstance->Start();
+}
+
+void StepProfiler::EndOfRun()
+{
+  if (fgInstance) fgInstance->Stop();
+}
+
+void StepProfiler::Report(G4int runID)
+{
+  std::vector<std::pair<NameKey, Entry>> rows;
+  {
+    G4AutoLock lock(&profileMutex);
+    rows.assign(mergedTable.begin(), mergedTable.end());
+    mergedTable.clear();
+  }
+  if (rows.empty()) return;
+
+  std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+    return a.second.nanoseconds > b.second.nanoseconds;
+  });
+
+  G4long totalSteps = 0;
+  std::chrono::nanoseconds::rep totalNanoseconds = 0;
+  for (const auto& row : rows) {
+    totalSteps += row.second.steps;
+    totalNanoseconds += row.second.nanoseconds;
+  }
+
+  // Whole table, for offline analysis
+  const G4String fileName = fgOutputPrefix + std::to_string(runID) + ".csv";
+  std::ofstream file(fileName);
+  if (file) {
+    file << "volume,particle,process,steps,tracks,seconds\n";
+    for (const auto& [names, entry] : rows) {
+      file << std::get<0>(names) << "," << std::get<1>(names) << "," << std::get<2>(names)
+           << "," << entry.steps << "," << entry.tracks << "," << entry.nanoseconds*1e-9
+           << "\n";
+    }
+  } else {
+    G4cerr << "ERROR: Could not open step profile file " << fileName << G4endl;
+  }
+
+  if (!TUNGSTEN_LOG_ENABLED(Logger::kRun)) return;
+
+  G4cout << "\n=== STEP PROFILE (top " << fgTopN << " of " << rows.size()
+         << " by time; all threads) ===\n"
+         << "Steps: " << totalSteps << ", stepping time " << totalNanoseconds*1e-9
+         << " s (" << (totalSteps > 0 ? G4double(totalNanoseconds)/totalSteps : 0.)
+         << " ns per step); full table in " << fileName << "\n"
+         << std::left << std::setw(14) << "Volume" << std::setw(12) << "Particle"
+         << std::setw(22) << "Process" << std::right << std::setw(12) << "Steps"
+         << std::setw(10) << "Tracks" << std::setw(11) << "Time [s]"
+         << std::setw(8) << "Time %" << std::setw(10) << "ns/step" << "\n";
+
+  const std::size_t nofRows = std::min<std::size_t>(rows.size(), std::max(fgTopN, 0));
+  for (std::size_t i = 0; i < nofRows; ++i) {
+    const auto& [names, entry] = rows[i];
+    G4cout << std::left << std::setw(14) << std::get<0>(names)
+           << std::setw(12) << std::get<1>(names) << std::setw(22) << std::get<2>(names)
+           << std::right << std::setw(12) << entry.steps << std::setw(10) << entry.tracks
+           << std::setw(11) << std::setprecision(4) << entry.nanoseconds*1e-9
+           << std::setw(8) << std::setprecision(3)
+           << (totalNanoseconds > 0 ? 100.*entry.nanoseconds/totalNanoseconds : 0.)
+           << std::setw(10) << std::setprecision(4)
+           << (entry.steps > 0 ? G4double(entry.nanoseconds)/entry.steps : 0.) << "\n";
+  }
+  G4cout << std::setprecision(6) << "=====================================" << G4endl;
+}
+
+G4GenericMessenger* StepProfiler::CreateMessenger()
+{
+  auto* messenger = new G4GenericMessenger(nullptr, "/tungsten/profile/",
+                                           "Step profiler (TUNGSTEN_STEP_PROFILER builds)");
+
+  // Read by every thread at the start of a run, so the commands stay on the master
+  messenger->DeclareProperty("enable", fgEnabled,
+                             "Profile steps per volume, particle and process")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclareProperty("top", fgTopN, "Number of entries in the printed report")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclareProperty("output", fgOutputPrefix,
+                             "The full table goes to <prefix><runID>.csv")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  return messenger;
+}
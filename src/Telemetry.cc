@@ -0,0 +1,239 @@
+#include "Telemetry.hh"
+#include "MemoryUsage.hh"
+
+#include "G4AutoLock.hh"
+#include "G4GenericMessenger.hh"
+#include "G4Threading.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  G4Mutex slotMutex = G4MUTEX_INITIALIZER;
+
+  // Sampler state, master only
+  std::thread sampler;
+  std::mutex samplerMutex;
+  std::condition_variable samplerCondition;
+  G4bool samplerStop = false;
+  G4int samplerRunID = 0;
+  G4int samplerTotalEvents = 0;
+  G4long samplerLastEvents = 0;
+  std::vector<G4long> samplerLastThreadEvents;
+
+  // Bin of an event time, and the time at the centre of a bin (seconds)
+  G4int TimeBin(G4double seconds, G4int binsPerOctave, G4int nofBins)
+  {
+    const G4double microseconds = seconds*1e6;
+    if (microseconds <= 1.) return 0;
+    const G4int bin = static_cast<G4int>(std::log2(microseconds)*binsPerOctave);
+    return std::min(bin, nofBins - 1);
+  }
+
+  G4double BinTime(G4int bin, G4int binsPerOctave)
+  {
+    return 1e-6*std::exp2((bin + 0.5)/binsPerOctave);
+  }
+}
+
+G4double Telemetry::fgInterval = 0.;
+G4String Telemetry::fgFileName = "telemetry.json";
+
+std::vector<std::unique_ptr<Telemetry::Slot>>& Telemetry::GetSlots()
+{
+  static std::vector<std::unique_ptr<Telemetry::Slot>> slots;
+  return slots;
+}
+
+Telemetry::Slot& Telemetry::GetSlot()
+{
+  static G4ThreadLocal Slot* slot = nullptr;
+  if (!slot) {
+    G4AutoLock lock(&slotMutex);
+    GetSlots().push_back(std::make_unique<Slot>());
+    slot = GetSlots().back().get();
+    slot->threadID = G4Threading::G4GetThreadId();
+  }
+  return *slot;
+}
+
+void Telemetry::BeginOfRun()
+{
+  if (!IsEnabled()) return;
+  Slot& slot = GetSlot();
+  slot.events = 0;
+  slot.tracks = 0;
+  slot.steps = 0;
+  for (auto& count : slot.eventTimes) count = 0;
+}
+
+void Telemetry::EndOfEvent()
+{
+  if (!IsEnabled()) return;
+  Slot& slot = GetSlot();
+  const std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - slot.eventStart;
+  slot.eventTimes[TimeBin(elapsed.count(), kBinsPerOctave, kNumberOfTimeBins)]
+    .fetch_add(1, std::memory_order_relaxed);
+  slot.events.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Telemetry::StartSampling(G4int runID, G4int nofEvents)
+{
+  if (!IsEnabled() || sampler.joinable()) return;
+
+  samplerStop = false;
+  samplerRunID = runID;
+  samplerTotalEvents = nofEvents;
+  samplerLastEvents = 0;
+  samplerLastThreadEvents.clear();
+
+  const G4double interval = fgInterval;
+  sampler = std::thread([interval]() {
+    const auto start = std::chrono::steady_clock::now();
+    const auto period = std::chrono::duration<G4double>(interval);
+    std::unique_lock<std::mutex> lock(samplerMutex);
+    while (!samplerCondition.wait_for(lock, period, [] { return samplerStop; })) {
+      const std::chrono::duration<G4double> elapsed = std::chrono::steady_clock::now() - start;
+      Sample(elapsed.count(), interval);
+    }
+  });
+}
+
+void Telemetry::StopSampling()
+{
+  if (!sampler.joinable()) return;
+  {
+    std::lock_guard<std::mutex> lock(samplerMutex);
+    samplerStop = true;
+  }
+  samplerCondition.notify_one();
+  sampler.join();
+}
+
+void Telemetry::Sample(G4double elapsed, G4double interval)
+{
+  // Snapshot of all slots (the counters keep moving while we read)
+  struct ThreadSample { G4int threadID; G4long events; };
+  std::vector<ThreadSample> threads;
+  std::array<G4long, kNumberOfTimeBins> times{};
+  G4long events = 0;
+  G4long tracks = 0;
+  G4long steps = 0;
+  {
+    G4AutoLock lock(&slotMutex);
+    for (const auto& slot : GetSlots()) {
+      const G4long slotEvents = slot->events.load(std::memory_order_relaxed);
+      events += slotEvents;
+      tracks += slot->tracks.load(std::memory_order_relaxed);
+      steps += slot->steps.load(std::memory_order_relaxed);
+      for (G4int i = 0; i < kNumberOfTimeBins; ++i) {
+        times[i] += slot->eventTimes[i].load(std::memory_order_relaxed);
+      }
+      // Workers, or the only thread of a sequential run; not the MT master
+      if (slotEvents > 0 || slot->threadID >= 0) {
+        threads.push_back({ slot->threadID, slotEvents });
+      }
+    }
+  }
+
+  // Event rate over the last interval, and the remaining time at that rate
+  const G4double rate = (events - samplerLastEvents)/interval;
+  const G4long remaining = std::max<G4long>(samplerTotalEvents - events, 0);
+  const G4double eta = rate > 0. ? remaining/rate : -1.;
+
+  // Percentiles of the event wall time
+  G4long counted = 0;
+  for (G4long count : times) counted += count;
+  auto percentile = [&](G4double fraction) {
+    G4long sum = 0;
+    for (G4int i = 0; i < kNumberOfTimeBins; ++i) {
+      sum += times[i];
+      if (sum > 0 && sum >= fraction*counted) return BinTime(i, kBinsPerOctave);
+    }
+    return 0.;
+  };
+  const G4double p50 = percentile(0.50);
+  const G4double p99 = percentile(0.99);
+
+  G4long minThreadEvents = 0;
+  G4long maxThreadEvents = 0;
+  if (!threads.empty()) {
+    auto [minThread, maxThread] = std::minmax_element(threads.begin(), threads.end(),
+      [](const ThreadSample& a, const ThreadSample& b) { return a.events < b.events; });
+    minThreadEvents = minThread->events;
+    maxThreadEvents = maxThread->events;
+  }
+
+  const G4double rss = MemoryUsage::GetCurrentRSS();
+  const G4double peakRSS = MemoryUsage::GetPeakRSS();
+  const G4double tracksPerEvent = events > 0 ? G4double(tracks)/events : 0.;
+  const G4double stepsPerEvent = events > 0 ? G4double(steps)/events : 0.;
+
+  std::ostringstream line;
+  line << "Telemetry run " << samplerRunID << ": " << events << "/" << samplerTotalEvents
+       << " events, " << rate << " events/s, ETA ";
+  if (eta >= 0.) line << eta << " s"; else line << "-";
+  line << ", event p50 " << p50*1e3 << " ms p99 " << p99*1e3 << " ms, "
+       << tracksPerEvent << " tracks/event, " << stepsPerEvent << " steps/event, RSS "
+       << rss << " MB (peak " << peakRSS << "), thread events " << minThreadEvents
+       << "-" << maxThreadEvents;
+  G4cout << line.str() << G4endl;
+
+  // Snapshot file, replaced atomically so readers never see half of it
+  std::ostringstream json;
+  json << "{\"run\": " << samplerRunID << ", \"elapsed_s\": " << elapsed
+       << ", \"events\": " << events << ", \"events_total\": " << samplerTotalEvents
+       << ", \"events_per_s\": " << rate << ", \"eta_s\": " << eta
+       << ", \"event_time_p50_s\": " << p50 << ", \"event_time_p99_s\": " << p99
+       << ", \"tracks_per_event\": " << tracksPerEvent
+       << ", \"steps_per_event\": " << stepsPerEvent
+       << ", \"rss_mb\": " << rss << ", \"peak_rss_mb\": " << peakRSS
+       << ", \"threads\": [";
+  samplerLastThreadEvents.resize(threads.size(), 0);
+  for (std::size_t i = 0; i < threads.size(); ++i) {
+    const G4double threadRate = (threads[i].events - samplerLastThreadEvents[i])/interval;
+    json << (i > 0 ? ", " : "") << "{\"id\": " << threads[i].threadID
+         << ", \"events\": " << threads[i].events << ", \"events_per_s\": " << threadRate << "}";
+    samplerLastThreadEvents[i] = threads[i].events;
+  }
+  json << "]}\n";
+
+  const G4String tmpName = fgFileName + ".tmp";
+  {
+    std::ofstream file(tmpName);
+    file << json.str();
+  }
+  std::rename(tmpName.c_str(), fgFileName.c_str());
+
+  samplerLastEvents = events;
+}
+
+G4GenericMessenger* Telemetry::CreateMessenger()
+{
+  auto* messenger = new G4GenericMessenger(nullptr, "/tungsten/telemetry/",
+                                           "Live progress of long runs");
+
+  // Read by every thread at the start of a run, so the commands stay on the master
+  messenger->DeclareProperty("interval", fgInterval,
+                             "Seconds between status lines and JSON snapshots "
+                             "during a run (0: off)")
+    .SetParameterName("interval", false)
+    .SetRange("interval >= 0.")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  messenger->DeclareProperty("file", fgFileName, "JSON snapshot file")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  return messenger;
+}
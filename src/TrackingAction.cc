@@ -0,0 +1,90 @@
+#include "TrackingAction.hh"
+#include "EventAction.hh"
+#include "RunAction.hh"
+#include "ParticleClassifier.hh"
+#include "Histograms.hh"
+#include "Telemetry.hh"
+#include "PionDecayTrackInfo.hh"
+#include "PionDecayRecord.hh"
+#include "Logger.hh"
+
+#include "G4Track.hh"
+#include "G4Step.hh"
+#include "G4TrackingManager.hh"
+#include "G4EventManager.hh"
+#include "G4Event.hh"
+#include "G4SystemOfUnits.hh"
+
+TrackingAction::TrackingAction(RunAction* runAction, EventAction* eventAction)
+: G4UserTrackingAction(),
+  fRunAction(runAction),
+  fEventAction(eventAction),
+  fClassifier(ParticleClassifier::Instance())
+{}
+
+TrackingAction::~TrackingAction()
+{}
+
+void TrackingAction::PreUserTrackingAction(const G4Track* track)
+{
+  const ParticleClassifier::Species species = fClassifier->Classify(track->GetDefinition());
+  if (species != ParticleClassifier::kOther) {
+    fEventAction->Count(RunStatistics::kProduced, species, track->GetWeight(),
+                        track->GetKineticEnergy()/MeV);
+  }
+}
+
+void TrackingAction::PostUserTrackingAction(const G4Track* track)
+{
+  Telemetry::CountTrack(track->GetCurrentStepNumber());
+
+  const ParticleClassifier::Species species = fClassifier->Classify(track->GetDefinition());
+  if (!ParticleClassifier::IsChargedPion(species)) return;
+
+  // The last step of a decaying pion ends in its decay vertex
+  const G4Step* step = track->GetStep();
+  if (step && fClassifier->IsDecay(species, step->GetPostStepPoint()->GetProcessDefinedStep())) {
+    Histograms::FillPionDecay(track->GetPosition().z(), track->GetWeight());
+    RecordDecay(track, step);
+  }
+}
+
+void TrackingAction::RecordDecay(const G4Track* pion, const G4Step* step)
+{
+  const ParticleClassifier::Species pionSpecies = fClassifier->Classify(pion->GetDefinition());
+  const G4VProcess* decay = step->GetPostStepPoint()->GetProcessDefinedStep();
+  const G4ThreeVector& vertex = pion->GetPosition();
+  const G4double pionEnergy = pion->GetKineticEnergy();
+
+  PionDecayRecord record;
+  record.eventID = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
+  record.pionSpecies = pionSpecies;
+  record.pionEnergy = pionEnergy/MeV;
+  for (G4int k = 0; k < 3; ++k) record.position[k] = vertex[k]/mm;
+
+  // The secondaries are not on the stack yet, so the tag is in place
+  // before the muons are tracked
+  G4TrackVector* secondaries = fpTrackingManager->GimmeSecondaries();
+  if (!secondaries) return;
+  for (G4Track* secondary : *secondaries) {
+    if (secondary->GetCreatorProcess() != decay) continue;
+    const ParticleClassifier::Species muonSpecies
+      = fClassifier->Classify(secondary->GetDefinition());
+    if (!ParticleClassifier::IsMuon(muonSpecies)) continue;
+
+    secondary->SetUserInformation(
+      new PionDecayTrackInfo(pionSpecies, pionEnergy, vertex.z()));
+
+    record.muonSpecies = muonSpecies;
+    record.muonEnergy = secondary->GetKineticEnergy()/MeV;
+    record.weight = secondary->GetWeight();
+    fRunAction->RecordPionDecay(record);
+
+    TUNGSTEN_LOG(Logger::kStep, "\n!!! PION DECAY DETECTED !!!\n"
+                 << ParticleClassifier::GetName(pionSpecies) << " → "
+                 << ParticleClassifier::GetName(muonSpecies)
+                 << "\nPosition: " << vertex/mm << " mm"
+                 << "\nParent Energy: " << pionEnergy/MeV << " MeV"
+                 << "\nMuon Energy: " << secondary->GetKineticEnergy()/MeV << " MeV");
+  }
+}
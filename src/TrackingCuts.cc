@@ -0,0 +1,54 @@
+#include "TrackingCuts.hh"
+
+#include "G4Track.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4GenericMessenger.hh"
+#include "G4SystemOfUnits.hh"
+
+// Well below the pion production threshold, so the muon/pion yields do not change
+TrackingCuts::TrackingCuts()
+: G4UserLimits("TrackingCuts"),
+  fGammaMinEkine(1.0*MeV),
+  fElectronMinEkine(1.0*MeV),
+  fNeutronMinEkine(10.0*MeV),
+  fMessenger(nullptr)
+{
+  DefineCommands();
+}
+
+TrackingCuts::~TrackingCuts()
+{
+  delete fMessenger;
+}
+
+G4double TrackingCuts::GetUserMinEkine(const G4Track& track)
+{
+  switch (track.GetDefinition()->GetPDGEncoding()) {
+    case 22:            return fGammaMinEkine;
+    case 11: case -11:  return fElectronMinEkine;
+    case 2112:          return fNeutronMinEkine;
+    default:            return 0.;
+  }
+}
+
+void TrackingCuts::DefineCommands()
+{
+  // One object shared by all threads, so the commands stay on the master
+  fMessenger = new G4GenericMessenger(this, "/tungsten/cuts/",
+                                      "Kinetic-energy tracking thresholds");
+
+  fMessenger->DeclarePropertyWithUnit("gammaMinEkine", "MeV", fGammaMinEkine,
+                                      "Stop gammas below this kinetic energy (0: never)")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclarePropertyWithUnit("electronMinEkine", "MeV", fElectronMinEkine,
+                                      "Stop e- and e+ below this kinetic energy (0: never)")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+
+  fMessenger->DeclarePropertyWithUnit("neutronMinEkine", "MeV", fNeutronMinEkine,
+                                      "Stop neutrons below this kinetic energy (0: never)")
+    .SetStates(G4State_PreInit, G4State_Idle)
+    .SetToBeBroadcasted(false);
+}
@@ -0,0 +1,9 @@
+#include "TungstenHit.hh"
+#include "G4SystemOfUnits.hh"
+
+G4ThreadLocal G4Allocator<TungstenHit>* TungstenHitAllocator = nullptr;
+
+void TungstenHit::Print()
+{
+  G4cout << "Tungsten energy deposit: " << fEdep/MeV << " MeV" << G4endl;
+}
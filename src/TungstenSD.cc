@@ -0,0 +1,97 @@
+#include "TungstenSD.hh"
+#include "PhaseSpace.hh"
+
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4SDManager.hh"
+#include "G4EventManager.hh"
+#include "G4Event.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+
+TungstenSD::TungstenSD(const G4String& name, const G4String& hitsCollectionName,
+                       const G4String& exitsCollectionName)
+: G4VSensitiveDetector(name),
+  fCollectionID(-1),
+  fExitsCollectionID(-1),
+  fHit(nullptr),
+  fExits(nullptr),
+  fRecordExits(false),
+  fKillEntering(false),
+  fMinKineticEnergy(0.),
+  fEventID(-1),
+  fExitsCapacity(256)
+{
+  collectionName.insert(hitsCollectionName);
+  collectionName.insert(exitsCollectionName);
+}
+
+void TungstenSD::Initialize(G4HCofThisEvent* hce)
+{
+  auto* hitsCollection = new TungstenHitsCollection(SensitiveDetectorName, collectionName[0]);
+  fExits = new PhaseSpaceHitsCollection(SensitiveDetectorName, collectionName[1]);
+  if (fCollectionID < 0) {
+    G4SDManager* sdManager = G4SDManager::GetSDMpointer();
+    fCollectionID = sdManager->GetCollectionID(hitsCollection);
+    fExitsCollectionID = sdManager->GetCollectionID(fExits);
+  }
+  hce->AddHitsCollection(fCollectionID, hitsCollection);
+  hce->AddHitsCollection(fExitsCollectionID, fExits);
+
+  fHit = new TungstenHit();
+  hitsCollection->insert(fHit);
+
+  fRecordExits = PhaseSpace::IsRecording();
+  fKillEntering = PhaseSpace::IsReplaying();
+  fMinKineticEnergy = PhaseSpace::GetMinKineticEnergy();
+  if (fRecordExits) {
+    fExits->GetVector()->reserve(fExitsCapacity);
+    fEventID = G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
+  }
+}
+
+G4bool TungstenSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  // Replay: whatever leaves the block again is already in the file
+  if (fKillEntering && step->GetPreStepPoint()->GetStepStatus() == fGeomBoundary) {
+    step->GetTrack()->SetTrackStatus(fStopAndKill);
+    return false;
+  }
+
+  G4double edep = step->GetTotalEnergyDeposit();
+  if (edep > 0.) fHit->AddEdep(edep);
+
+  if (fRecordExits && step->GetPostStepPoint()->GetStepStatus() == fGeomBoundary) {
+    RecordExit(step);
+  }
+  return edep > 0.;
+}
+
+void TungstenSD::EndOfEvent(G4HCofThisEvent*)
+{
+  fExitsCapacity = std::max(fExitsCapacity, fExits->GetVector()->size());
+}
+
+void TungstenSD::RecordExit(const G4Step* step)
+{
+  const G4Track* track = step->GetTrack();
+  const G4int pdgCode = track->GetDefinition()->GetPDGEncoding();
+  const G4double energy = track->GetKineticEnergy();
+  if (pdgCode == 0 || energy <= 0. || energy < fMinKineticEnergy) return;
+
+  const G4ThreeVector& position = step->GetPostStepPoint()->GetPosition();
+  const G4ThreeVector& direction = track->GetMomentumDirection();
+
+  PhaseSpaceRecord record;
+  record.eventID = fEventID;
+  record.pdgCode = pdgCode;
+  record.kineticEnergy = energy/MeV;
+  for (G4int k = 0; k < 3; ++k) {
+    record.position[k] = position[k]/mm;
+    record.direction[k] = direction[k];
+  }
+  record.weight = track->GetWeight();
+  fExits->insert(new PhaseSpaceHit(record));
+}
@@ -0,0 +1,110 @@
+// Checks that the hit path does not allocate in steady state: drives the
+// HitArena (Reset/Add) and the bulk hand-off to HitWriter for many events,
+// as EventAction does, and counts the heap allocations of this thread after
+// the first event. The first event is the busiest and has more hits than
+// the arena's initial capacity, so the arena must grow in that event and
+// in no other.
+// The written file is read back to check that no hit was lost.
+//
+// Only built with -DTUNGSTEN_COUNT_ALLOCATIONS=ON; registered with CTest as
+// hit_path_allocations. Exit code 0 if nothing was allocated.
+//
+// Usage: tungsten_hit_path_allocations [events]
+
+#include "AllocationCounter.hh"
+#include "HitArena.hh"
+#include "HitFileReader.hh"
+#include "HitWriter.hh"
+#include "ParticleClassifier.hh"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+  const std::size_t kMaxHitsPerEvent = 200;  // above the initial arena capacity
+
+  HitRecord MakeHit(G4int eventID, std::size_t i)
+  {
+    HitRecord record{};
+    record.eventID = eventID;
+    record.species = G4int(i % 4);
+    record.detectorID = 1 + G4int(i % 2);
+    record.kineticEnergy = 100.f + i;
+    record.position[2] = 1500.f;
+    record.direction[2] = 1.f;
+    record.weight = 1.f;
+    record.parentSpecies = ParticleClassifier::kOther;
+    record.creatorProcess = -1;
+    return record;
+  }
+}
+
+int main(int argc, char** argv)
+{
+  // Enough events for the writer to cycle through all its blocks many times
+  const G4int nofEvents = argc > 1 ? std::atoi(argv[1]) : 50000;
+  const G4String fileName = "hit_path_allocations.bin";
+
+  HitWriter writer;
+  if (!writer.Open(fileName)) {
+    std::cerr << "ERROR: Could not open " << fileName << std::endl;
+    return 1;
+  }
+  HitArena* arena = HitArena::Instance();
+  arena->BeginOfRun();
+
+  std::size_t nofHits = 0;
+  std::size_t allocations = 0;
+  G4int growthEvents = 0;  // events in which the arena grew
+  G4bool grewInFirstEvent = false;
+  for (G4int eventID = 0; eventID < nofEvents; ++eventID) {
+    const std::size_t start = AllocationCounter::Get();
+    const std::size_t growths = arena->GetGrowths();
+
+    // Event 0 has the most hits, the others vary below it
+    const std::size_t hitsInEvent = eventID == 0
+      ? kMaxHitsPerEvent : (std::size_t(eventID)*7) % (kMaxHitsPerEvent + 1);
+    arena->Reset();
+    for (std::size_t i = 0; i < hitsInEvent; ++i) arena->Add(MakeHit(eventID, i));
+    writer.Write(arena->GetRecords(), arena->GetSize());
+    nofHits += arena->GetSize();
+
+    if (eventID > 0) allocations += AllocationCounter::Get() - start;
+    if (arena->GetGrowths() != growths) {
+      ++growthEvents;
+      if (eventID == 0) grewInFirstEvent = true;
+    }
+  }
+  writer.Close();
+
+  // Read back outside the counted part
+  std::size_t nofRead = 0;
+  HitFileReader reader;
+  std::vector<HitRecord> records;
+  if (reader.Open(fileName)) {
+    while (reader.ReadBlock(records)) nofRead += records.size();
+  }
+  reader.Close();
+  std::remove(fileName.c_str());
+
+  std::cout << nofEvents << " events, " << nofHits << " hits written, " << nofRead
+            << " read back, " << allocations << " allocations after the first event, "
+            << "arena grew in " << growthEvents << " events" << std::endl;
+
+  if (nofRead != nofHits) {
+    std::cerr << "FAIL: hits lost in the hit file" << std::endl;
+    return 1;
+  }
+  if (!grewInFirstEvent || growthEvents != 1) {
+    std::cerr << "FAIL: the arena should grow in the first event only" << std::endl;
+    return 1;
+  }
+  if (allocations > 0) {
+    std::cerr << "FAIL: the hit path allocates after the first event" << std::endl;
+    return 1;
+  }
+  return 0;
+}
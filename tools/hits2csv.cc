@@ -0,0 +1,83 @@
+// Converts a binary hit file (particle_dataN.bin) into the CSV layout the
+// simulation used to write directly (particle_dataN.csv):
+//
+//   ParticleType,Energy
+//   mu+,1234.5        <- detector 1
+//   2mu+,987.6        <- detector 2
+//
+// With -w a third column holds the statistical weight of each hit (only
+// different from 1 in runs with pion-decay biasing). With -d two more
+// columns give the parent pion of muons from a pion decay and the decay z
+// in mm ("other" and 0 for all other hits).
+//
+// Usage: tungsten_hits2csv [-w] [-d] particle_data0.bin [particle_data0.csv]
+
+#include "HitFileReader.hh"
+#include "ParticleClassifier.hh"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+  bool withWeights = false;
+  bool withDecays = false;
+  int first = 1;
+  for (; first < argc && argv[first][0] == '-'; ++first) {
+    const std::string option = argv[first];
+    if (option == "-w") {
+      withWeights = true;
+    } else if (option == "-d") {
+      withDecays = true;
+    } else {
+      break;
+    }
+  }
+  if (argc - first < 1 || argc - first > 2) {
+    std::cerr << "Usage: " << argv[0] << " [-w] [-d] <hits.bin> [output.csv]" << std::endl;
+    return 1;
+  }
+
+  std::string inputName = argv[first];
+  std::string outputName;
+  if (argc - first == 2) {
+    outputName = argv[first + 1];
+  } else {
+    std::string::size_type dot = inputName.rfind(".bin");
+    outputName = (dot == std::string::npos ? inputName : inputName.substr(0, dot)) + ".csv";
+  }
+
+  HitFileReader reader;
+  if (!reader.Open(inputName)) return 1;
+
+  std::ofstream output(outputName);
+  if (!output.is_open()) {
+    std::cerr << "ERROR: Could not open output file " << outputName << std::endl;
+    return 1;
+  }
+
+  output << "ParticleType,Energy" << (withWeights ? ",Weight" : "")
+         << (withDecays ? ",ParentType,DecayZ" : "") << "\n";
+
+  std::vector<HitRecord> records;
+  std::size_t nofHits = 0;
+  while (reader.ReadBlock(records)) {
+    for (const HitRecord& hit : records) {
+      auto species = static_cast<ParticleClassifier::Species>(hit.species);
+      output << ParticleClassifier::GetHitLabel(hit.detectorID, species) << ","
+             << hit.kineticEnergy;
+      if (withWeights) output << "," << hit.weight;
+      if (withDecays) {
+        auto parent = static_cast<ParticleClassifier::Species>(hit.parentSpecies);
+        output << "," << ParticleClassifier::GetName(parent) << "," << hit.decayZ;
+      }
+      output << "\n";
+    }
+    nofHits += records.size();
+  }
+
+  std::cout << "Wrote " << nofHits << " hits to " << outputName << std::endl;
+  return 0;
+}
@@ -1,49 +1,193 @@
 #include "DetectorConstruction.hh"
 #include "PhysicsList.hh"
 #include "ActionInitialization.hh"
+#include "RunAction.hh"
+#include "ParameterScan.hh"
 
 #include "G4RunManagerFactory.hh"
 #include "G4UImanager.hh"
+#include "G4StateManager.hh"
+#include "G4UIcommand.hh"
 #include "G4VisExecutive.hh"
 #include "G4UIExecutive.hh"
+#include "G4Timer.hh"
 #include "Randomize.hh"
+#include "Logger.hh"
+#include "MemoryUsage.hh"
+
+namespace
+{
+  void PrintUsage()
+  {
+    G4cerr << " Usage: " << G4endl;
+    G4cerr << " tungsten_sim [macro]" << G4endl;
+    G4cerr << " tungsten_sim [-m macro] [-t nThreads] [-s seed] [-n nEvents]"
+           << " [-o outputPrefix] [--runmanager serial|mt|tasking]"
+           << " [--physics full|production|fast] [--physics-cache dir]"
+           << " [--check-geometry]" << G4endl;
+    G4cerr << "   -m  macro to execute (batch mode, no visualization)" << G4endl;
+    G4cerr << "   -t, --threads  number of worker threads"
+           << " (also /run/numberOfThreads before /run/initialize)" << G4endl;
+    G4cerr << "   -s  random seed" << G4endl;
+    G4cerr << "   -n  run /run/beamOn nEvents after the macro (batch mode)" << G4endl;
+    G4cerr << "   -o  write the raw hit files, named <prefix><runID>.bin"
+           << " (also /tungsten/output/hits)" << G4endl;
+    G4cerr << "   --runmanager  run manager type (default: Geant4's default)" << G4endl;
+    G4cerr << "   --physics  physics profile (default: full)" << G4endl;
+    G4cerr << "   --physics-cache  store the physics tables in dir, and retrieve"
+           << " them when the list and cuts match (also /tungsten/physics/cacheDir)"
+           << G4endl;
+    G4cerr << "   --check-geometry  check all placements for overlaps and print the"
+           << " voxelization statistics; exits with status 2 on overlaps" << G4endl;
+  }
+
+  G4bool ParseRunManagerType(const G4String& name, G4RunManagerType& type)
+  {
+    if      (name == "serial")  type = G4RunManagerType::Serial;
+    else if (name == "mt")      type = G4RunManagerType::MT;
+    else if (name == "tasking") type = G4RunManagerType::Tasking;
+    else return false;
+    return true;
+  }
+}
 
 int main(int argc, char** argv)
 {
-  // Construct the default run manager
-  auto* runManager = G4RunManagerFactory::CreateRunManager();
+  // Wall time of the whole job, including initialization
+  G4Timer jobTimer;
+  jobTimer.Start();
+  ParameterScan::StartJob();
 
-  // Set mandatory initialization classes
-  runManager->SetUserInitialization(new DetectorConstruction());
-  runManager->SetUserInitialization(new PhysicsList());
-  runManager->SetUserInitialization(new ActionInitialization());
+  // Evaluate arguments
+  G4String macro;
+  G4String outputPrefix;
+  G4int nofThreads = 0;
+  G4long seed = 0;
+  G4int nofEvents = 0;
+  G4RunManagerType runManagerType = G4RunManagerType::Default;
+  G4bool checkGeometry = false;
+  G4String physicsProfile = "full";
+  G4String physicsCache;
 
-  // Initialize G4 kernel
-  runManager->Initialize();
+  if (argc == 2 && G4String(argv[1])[0] != '-') {
+    // Legacy form: tungsten_sim run.mac
+    macro = argv[1];
+  }
+  else {
+    for (G4int i = 1; i < argc; i += 2) {
+      G4String option = argv[i];
+      if (option == "--check-geometry") {
+        // The only option without a value
+        checkGeometry = true;
+        --i;
+        continue;
+      }
+      if (i + 1 >= argc) {
+        PrintUsage();
+        return 1;
+      }
+      if      (option == "-m") macro = argv[i+1];
+      else if (option == "-t" || option == "--threads") {
+        nofThreads = G4UIcommand::ConvertToInt(argv[i+1]);
+      }
+      else if (option == "--runmanager") {
+        if (!ParseRunManagerType(argv[i+1], runManagerType)) {
+          PrintUsage();
+          return 1;
+        }
+      }
+      else if (option == "--physics") {
+        PhysicsList::Profile profile;
+        physicsProfile = argv[i+1];
+        if (!PhysicsList::ParseProfile(physicsProfile, profile)) {
+          PrintUsage();
+          return 1;
+        }
+      }
+      else if (option == "--physics-cache") physicsCache = argv[i+1];
+      else if (option == "-s") seed = G4UIcommand::ConvertToLongInt(argv[i+1]);
+      else if (option == "-n") nofEvents = G4UIcommand::ConvertToInt(argv[i+1]);
+      else if (option == "-o") outputPrefix = argv[i+1];
+      else {
+        PrintUsage();
+        return 1;
+      }
+    }
+  }
 
-  // Initialize visualization
-  G4VisManager* visManager = new G4VisExecutive();
-  visManager->Initialize();
+  // Batch mode whenever there is something to run without a user
+  G4bool batch = !macro.empty() || nofEvents > 0 || checkGeometry;
+
+  // Detect interactive mode and define UI session
+  G4UIExecutive* ui = nullptr;
+  if (!batch) {
+    ui = new G4UIExecutive(argc, argv);
+  }
+
+  // Construct the run manager (a thread count of 0 keeps Geant4's default,
+  // which also honours G4FORCENUMBEROFTHREADS)
+  auto* runManager = G4RunManagerFactory::CreateRunManager(runManagerType, nofThreads);
+  if (seed > 0) {
+    G4Random::setTheSeed(seed);
+  }
+  if (!outputPrefix.empty()) {
+    RunAction::SetOutputPrefix(outputPrefix);
+    RunAction::SetWriteHits(true);
+  }
+
+  // Set mandatory initialization classes
+  auto* detector = new DetectorConstruction();
+  runManager->SetUserInitialization(detector);
+  auto* physicsList = new PhysicsList(physicsProfile);
+  physicsList->SetCacheDirectory(physicsCache);
+  runManager->SetUserInitialization(physicsList);
+  runManager->SetUserInitialization(new ActionInitialization());
 
   // Get the pointer to the User Interface manager
   G4UImanager* UImanager = G4UImanager::GetUIpointer();
 
-  if (argc != 1) {
-    // Batch mode
-    G4String command = "/control/execute ";
-    G4String fileName = argv[1];
-    UImanager->ApplyCommand(command + fileName);
+  // Visualization only exists in interactive sessions
+  G4VisManager* visManager = nullptr;
+
+  if (batch) {
+    // Nobody draws trajectories in batch mode, so never store them
+    UImanager->ApplyCommand("/tracking/storeTrajectory 0");
+    if (!macro.empty()) {
+      UImanager->ApplyCommand("/control/execute " + macro);
+    }
+    if (checkGeometry || nofEvents > 0) {
+      // The macro may already have initialized the kernel
+      if (G4StateManager::GetStateManager()->GetCurrentState() == G4State_PreInit) {
+        UImanager->ApplyCommand("/run/initialize");
+      }
+    }
+    if (checkGeometry && detector->CheckGeometry() > 0) {
+      G4cerr << "Geometry check failed: overlapping volumes" << G4endl;
+      delete runManager;
+      return 2;
+    }
+    if (nofEvents > 0) {
+      UImanager->ApplyCommand("/run/beamOn " + std::to_string(nofEvents));
+    }
   }
   else {
     // Interactive mode
-    G4UIExecutive* ui = new G4UIExecutive(argc, argv);
+    visManager = new G4VisExecutive();
+    visManager->Initialize();
     UImanager->ApplyCommand("/control/execute init_vis.mac");
     ui->SessionStart();
     delete ui;
   }
 
+  ParameterScan::PrintSummary();
+
+  // Parsed by scripts/physics_benchmark.sh
+  jobTimer.Stop();
+  TUNGSTEN_LOG(Logger::kRun, "Job: " << jobTimer.GetRealElapsed() << " s wall time, peak RSS "
+               << MemoryUsage::GetPeakRSS() << " MB");
+
   // Job termination
   delete visManager;
   delete runManager;
   return 0;
-}
\ No newline at end of file
+}